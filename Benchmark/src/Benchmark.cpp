@@ -0,0 +1,112 @@
+#include "Benchmark.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "GLDebug.h"
+#include "Window.h"
+#include "Logger/Logger.h"
+
+
+bool BenchmarkOptions::parse(int argc, char** argv, int first)
+{
+	for (int i = first; i < argc; i++)
+	{
+		const char* name = argv[i];
+		if (std::strcmp(name, "--infinite-grid") == 0)
+		{
+			infiniteGrid = true;
+			continue;
+		}
+
+		if (i + 1 >= argc)
+		{
+			LOG_ERROR("Missing value for {}", name);
+			return false;
+		}
+		const char* value = argv[++i];
+
+		if (std::strcmp(name, "--frames") == 0)
+			frames = (uint32_t)std::max(1, std::atoi(value));
+		else if (std::strcmp(name, "--warmup") == 0)
+			warmup = (uint32_t)std::max(0, std::atoi(value));
+		else if (std::strcmp(name, "--size") == 0)
+		{
+			if (std::sscanf(value, "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+			{
+				LOG_ERROR("Expected --size WIDTHxHEIGHT, got {}", value);
+				return false;
+			}
+		}
+		else if (std::strcmp(name, "--segments") == 0)
+		{
+			// Accepts a plain count or millions, e.g. "2M".
+			double count = std::atof(value);
+			if (std::strchr(value, 'M') || std::strchr(value, 'm'))
+				count *= 1e6;
+			segments = (uint32_t)std::clamp(count, 1.0, 1e9);
+		}
+		else if (std::strcmp(name, "--threshold") == 0)
+			threshold = (float)std::atof(value);
+		else if (std::strcmp(name, "--max-p95") == 0)
+			maxP95 = (float)std::atof(value);
+		else if (std::strcmp(name, "--log") == 0)
+		{
+			if (!Log::Configure(value))
+				return false;
+		}
+		else
+		{
+			LOG_ERROR("Unknown option {}", name);
+			return false;
+		}
+	}
+	return true;
+}
+
+void PrintPercentiles(const char* label, const Percentiles& percentiles)
+{
+	std::printf("%-24s n=%-6u mean %8.3f  p50 %8.3f  p90 %8.3f  p95 %8.3f  p99 %8.3f  max %8.3f ms\n", label,
+		percentiles.count, percentiles.mean, percentiles.p50, percentiles.p90, percentiles.p95, percentiles.p99, percentiles.max);
+}
+
+static void OnGlfwError(int errorCode, const char* description)
+{
+	LOG_ERROR("GLFW error {:#x}: {}", errorCode, description);
+}
+
+HeadlessContext::HeadlessContext(int32_t width, int32_t height)
+	: m_Window { nullptr }, m_Valid { false }
+{
+	glfwSetErrorCallback(OnGlfwError);
+	glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	if (!glfwInit())
+	{
+		LOG_ERROR("Failed to initialize GLFW on the null platform");
+		return;
+	}
+
+	m_Window = new Window(width, height, "Benchmark", true);
+	if (!m_Window->isValid() || !gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		LOG_ERROR("Failed to create a headless OpenGL context");
+		return;
+	}
+
+#ifdef LINES_DEBUG
+	GLDebug::Init(DebugSeverity::Low);
+#endif
+
+	// Never wait for a vertical blank; the benchmarks time the work, not the display.
+	glfwSwapInterval(0);
+	// Printed rather than logged so it stays next to the results in every build.
+	std::printf("renderer: %s (%s)\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+	m_Valid = true;
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	delete m_Window;
+	glfwTerminate();
+}
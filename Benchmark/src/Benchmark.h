@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Profiler/Telemetry.h"
+
+class Window;
+
+// Options shared by every benchmark, parsed from "--name value" pairs.
+struct BenchmarkOptions
+{
+	uint32_t frames { 600 };
+	uint32_t warmup { 60 };
+	int32_t width { 1280 }, height { 720 };
+	float maxP95 { 0.f }; // fail the run when the p95 frame time exceeds this, 0 disables the gate
+	bool infiniteGrid { false };
+	uint32_t segments { 1000000 };
+	float threshold { 0.f }; // compare fails when a p95 regresses by more than this many percent
+
+	// Returns false and logs the offending argument on malformed input.
+	bool parse(int argc, char** argv, int first);
+};
+
+void PrintPercentiles(const char* label, const Percentiles& percentiles);
+
+// Initializes GLFW on its null platform and opens an invisible, software-rendered
+// window, so the benchmarks run on machines without a display or GPU.
+class HeadlessContext
+{
+public:
+	HeadlessContext(int32_t width, int32_t height);
+	~HeadlessContext();
+
+	inline bool isValid() const { return m_Valid; }
+	inline Window* getWindow() const { return m_Window; }
+private:
+	Window* m_Window;
+	bool m_Valid;
+};
@@ -0,0 +1,63 @@
+#include "CompareRuns.h"
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Logger/Logger.h"
+#include "Profiler/Telemetry.h"
+
+
+static double Change(double base, double candidate)
+{
+	return base > 0.0 ? (candidate - base) / base * 100.0 : 0.0;
+}
+
+int RunCompare(const char* basePath, const char* candidatePath, const BenchmarkOptions& options)
+{
+	std::vector<FrameSample> base, candidate;
+	if (!Telemetry::ReadCsv(basePath, base) || !Telemetry::ReadCsv(candidatePath, candidate))
+		return 2;
+
+	std::printf("base      %s (%zu frames)\ncandidate %s (%zu frames)\n\n", basePath, base.size(), candidatePath, candidate.size());
+	std::printf("%-6s %-4s %10s %10s %9s\n", "metric", "", "base", "candidate", "change");
+
+	struct Metric
+	{
+		const char* name;
+		float FrameSample::* field;
+	};
+	const Metric metrics[] = { { "cpu", &FrameSample::cpuMs }, { "gpu", &FrameSample::gpuMs }, { "swap", &FrameSample::swapMs } };
+
+	bool regressed = false;
+	for (const Metric& metric : metrics)
+	{
+		Percentiles a = Telemetry::Summarize(base, metric.field);
+		Percentiles b = Telemetry::Summarize(candidate, metric.field);
+
+		std::printf("%-6s %-4s %10.3f %10.3f %+8.1f%%\n", metric.name, "p50", a.p50, b.p50, Change(a.p50, b.p50));
+		std::printf("%-6s %-4s %10.3f %10.3f %+8.1f%%\n", "", "p95", a.p95, b.p95, Change(a.p95, b.p95));
+		std::printf("%-6s %-4s %10.3f %10.3f %+8.1f%%\n", "", "p99", a.p99, b.p99, Change(a.p99, b.p99));
+
+		// Swap time mostly measures the compositor, so only cpu and gpu gate the comparison.
+		if (options.threshold > 0.f && metric.field != &FrameSample::swapMs && Change(a.p95, b.p95) > options.threshold)
+		{
+			LOG_ERROR("{} p95 regressed by {:.1f}% (threshold {:.1f}%)", metric.name, Change(a.p95, b.p95), options.threshold);
+			regressed = true;
+		}
+	}
+
+	auto average = [](const std::vector<FrameSample>& samples, auto field)
+	{
+		double sum = 0.0;
+		for (const FrameSample& sample : samples)
+			sum += (double)(sample.*field);
+		return samples.empty() ? 0.0 : sum / samples.size();
+	};
+
+	double drawsA = average(base, &FrameSample::drawCalls), drawsB = average(candidate, &FrameSample::drawCalls);
+	double bytesA = average(base, &FrameSample::bytesUploaded), bytesB = average(candidate, &FrameSample::bytesUploaded);
+	std::printf("%-6s %-4s %10.1f %10.1f %+8.1f%%\n", "draws", "avg", drawsA, drawsB, Change(drawsA, drawsB));
+	std::printf("%-6s %-4s %10.1f %10.1f %+8.1f%%\n", "KiB", "avg", bytesA / 1024.0, bytesB / 1024.0, Change(bytesA, bytesB));
+
+	return regressed ? 1 : 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+struct BenchmarkOptions;
+
+// Diffs two telemetry files written by "Lines --benchmark N --telemetry file.csv".
+// Returns non-zero when a p95 timing regressed by more than options.threshold percent.
+int RunCompare(const char* basePath, const char* candidatePath, const BenchmarkOptions& options);
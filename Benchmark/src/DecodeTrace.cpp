@@ -0,0 +1,89 @@
+#include "DecodeTrace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <spdlog/fmt/bundled/args.h>
+
+#include "Logger/Logger.h"
+#include "Profiler/TraceLog.h"
+
+
+template<typename T>
+static void PushArg(fmt::dynamic_format_arg_store<fmt::format_context>& store, const uint8_t*& data)
+{
+	T value;
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	store.push_back(value);
+}
+
+static std::string FormatRecord(const TraceFormat& format, const TraceRecord& record)
+{
+	fmt::dynamic_format_arg_store<fmt::format_context> store;
+	const uint8_t* data = record.payload;
+	for (TraceArg arg : format.args)
+	{
+		switch (arg)
+		{
+		case TraceArg::Bool:	PushArg<bool>(store, data); break;
+		case TraceArg::Int8:	PushArg<int8_t>(store, data); break;
+		case TraceArg::UInt8:	PushArg<uint8_t>(store, data); break;
+		case TraceArg::Int16:	PushArg<int16_t>(store, data); break;
+		case TraceArg::UInt16:	PushArg<uint16_t>(store, data); break;
+		case TraceArg::Int32:	PushArg<int32_t>(store, data); break;
+		case TraceArg::UInt32:	PushArg<uint32_t>(store, data); break;
+		case TraceArg::Int64:	PushArg<int64_t>(store, data); break;
+		case TraceArg::UInt64:	PushArg<uint64_t>(store, data); break;
+		case TraceArg::Float:	PushArg<float>(store, data); break;
+		case TraceArg::Double:	PushArg<double>(store, data); break;
+		}
+	}
+
+	try
+	{
+		return fmt::vformat(format.text, store);
+	}
+	catch (const fmt::format_error& error)
+	{
+		return format.text + " <" + error.what() + ">";
+	}
+}
+
+int RunDecodeTrace(const char* path)
+{
+	TraceFile file;
+	if (!TraceLog::Read(path, file))
+		return 2;
+
+	struct Entry
+	{
+		const TraceThread* thread;
+		const TraceRecord* record;
+	};
+	std::vector<Entry> entries;
+	for (const TraceThread& thread : file.threads)
+	{
+		for (const TraceRecord& record : thread.records)
+			entries.push_back({ &thread, &record });
+	}
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.record->time < b.record->time; });
+
+	// A slot overwritten while the trace was saved can carry an id that was never registered.
+	uint32_t skipped = 0;
+	for (const Entry& entry : entries)
+	{
+		if (entry.record->format >= file.formats.size())
+		{
+			skipped++;
+			continue;
+		}
+		std::string text = FormatRecord(file.formats[entry.record->format], *entry.record);
+		std::printf("%14.6f ms  %-14s %s\n", entry.record->time * 1e-6, entry.thread->name.c_str(), text.c_str());
+	}
+
+	if (skipped)
+		LOG_WARN("Skipped {} records with an unknown format", skipped);
+	return 0;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Prints a binary trace saved by TraceLog::Save as text, every thread merged in time order.
+int RunDecodeTrace(const char* path);
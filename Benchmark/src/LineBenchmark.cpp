@@ -0,0 +1,213 @@
+#include "LineBenchmark.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Shader.h"
+#include "ShaderBatch.h"
+#include "Logger/Logger.h"
+#include "Profiler/CpuProfiler.h"
+#include "Renderer/Camera.h"
+#include "Renderer/GLState.h"
+#include "Renderer/LineBatch.h"
+#include "Renderer/ThickLines.h"
+#include "Renderer/UniformBuffer.h"
+
+
+// Thousands of draw calls per frame already show the trend; a million would only make the
+// run take minutes.
+constexpr uint32_t PerSegmentLimit = 1 << 16;
+
+struct StrategyResult
+{
+	Percentiles cpu, gpu, frame;
+};
+
+static std::vector<LineVertex> RandomSegments(uint32_t count)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-10.f, 10.f);
+	std::uniform_real_distribution<float> offset(-1.f, 1.f);
+	std::uniform_real_distribution<float> channel(.2f, 1.f);
+
+	std::vector<LineVertex> vertices;
+	vertices.reserve(2 * (size_t)count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		glm::vec3 start = { position(random), position(random), position(random) };
+		glm::vec3 end = start + glm::vec3(offset(random), offset(random), offset(random));
+		glm::vec3 color = { channel(random), channel(random), channel(random) };
+		vertices.push_back({ start, color });
+		vertices.push_back({ end, color });
+	}
+	return vertices;
+}
+
+static uint32_t CreateLineArray(uint32_t buffer)
+{
+	uint32_t vertexArray;
+	glGenVertexArrays(1, &vertexArray);
+	glBindVertexArray(vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
+	return vertexArray;
+}
+
+// Times submit on the CPU, the GPU work with GL_TIME_ELAPSED, and the whole frame up to glFinish.
+static StrategyResult Measure(const BenchmarkOptions& options, const std::function<void()>& submit)
+{
+	uint32_t query;
+	glGenQueries(1, &query);
+
+	std::vector<double> cpu, gpu, frame;
+	for (uint32_t i = 0; i < options.warmup + options.frames; i++)
+	{
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		uint64_t start = CpuProfiler::Now();
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		submit();
+		glEndQuery(GL_TIME_ELAPSED);
+		uint64_t submitted = CpuProfiler::Now();
+		glFinish();
+		uint64_t finished = CpuProfiler::Now();
+
+		if (i < options.warmup)
+			continue;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		cpu.push_back((submitted - start) * 1e-6);
+		gpu.push_back(elapsed * 1e-6);
+		frame.push_back((finished - start) * 1e-6);
+	}
+
+	glDeleteQueries(1, &query);
+	return { Percentiles::Compute(cpu), Percentiles::Compute(gpu), Percentiles::Compute(frame) };
+}
+
+static void PrintResult(const char* name, uint32_t segments, uint32_t draws, const StrategyResult& result)
+{
+	double segmentsPerSecond = result.frame.p50 > 0.0 ? segments / (result.frame.p50 * 1e-3) : 0.0;
+	std::printf("%-22s %10u %8u %10.3f %10.3f %10.3f %12.2f\n", name, segments, draws,
+		result.cpu.p50, result.gpu.p50, result.frame.p50, segmentsPerSecond * 1e-6);
+}
+
+int RunLineBenchmark(const BenchmarkOptions& options)
+{
+	HeadlessContext context(options.width, options.height);
+	if (!context.isValid())
+		return 2;
+
+	ShaderBatch shaders;
+	Shader* shader = shaders.add("res/shaders/shader.vs", "res/shaders/shader.fs");
+	ThickLines thickLines(shaders);
+	shaders.finish();
+
+	Camera camera(glm::radians(75.f), 0.1f, 100.f, glm::vec2((float)options.width, (float)options.height));
+	camera.lookAt(glm::vec3(0.f, 8.f, 24.f), glm::vec3(0.f));
+	FrameData frame = { camera.getView(), camera.getProjection(), camera.getViewProj(), camera.getInverseViewProj(),
+		glm::vec4(camera.getPosition(), 1.f), camera.getViewport(), glm::vec2(0.f) };
+
+	UniformBuffer frameBuffer(sizeof(FrameData), UniformBinding::Frame);
+	frameBuffer.setData(&frame, sizeof(frame));
+
+	glViewport(0, 0, options.width, options.height);
+	glEnable(GL_DEPTH_TEST);
+	glClearColor(0.f, 0.f, 0.f, 1.f);
+
+	const uint32_t segments = options.segments;
+	std::vector<LineVertex> vertices = RandomSegments(segments);
+	const GLsizeiptr size = (GLsizeiptr)vertices.size() * sizeof(LineVertex);
+
+	uint32_t staticBuffer;
+	glGenBuffers(1, &staticBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, staticBuffer);
+	glBufferData(GL_ARRAY_BUFFER, size, vertices.data(), GL_STATIC_DRAW);
+	uint32_t staticArray = CreateLineArray(staticBuffer);
+
+	uint32_t instancedArray;
+	glGenVertexArrays(1, &instancedArray);
+	glBindVertexArray(instancedArray);
+	ThickLines::setupSegmentAttributes(staticBuffer);
+
+	uint32_t streamBuffer;
+	glGenBuffers(1, &streamBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, streamBuffer);
+	glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	uint32_t streamArray = CreateLineArray(streamBuffer);
+
+	LineBatch lineBatch;
+
+	std::printf("lines: %u random segments, %dx%d, %u frames\n", segments, options.width, options.height, options.frames);
+	std::printf("%-22s %10s %8s %10s %10s %10s %12s\n", "strategy", "segments", "draws", "cpu ms", "gpu ms", "frame ms", "Mseg/s");
+
+	// One draw call per segment, as the grid used to be drawn.
+	uint32_t perSegment = std::min(segments, PerSegmentLimit);
+	shader->bind();
+	shader->setUniformMat4("u_Model", glm::identity<glm::mat4>());
+	PrintResult("per-segment draws", perSegment, perSegment, Measure(options, [&]()
+	{
+		glBindVertexArray(staticArray);
+		for (uint32_t i = 0; i < perSegment; i++)
+			glDrawArrays(GL_LINES, 2 * i, 2);
+	}));
+
+	PrintResult("static buffer", segments, 1, Measure(options, [&]()
+	{
+		glBindVertexArray(staticArray);
+		glDrawArrays(GL_LINES, 0, 2 * segments);
+	}));
+
+	// The thick-line path: a screen-space quad per instance instead of a GL line.
+	PrintResult("instanced quads", segments, 1, Measure(options, [&]()
+	{
+		thickLines.bind(1.f);
+		glBindVertexArray(instancedArray);
+		ThickLines::draw(segments);
+	}));
+
+	shader->bind();
+	PrintResult("orphaned glBufferData", segments, 1, Measure(options, [&]()
+	{
+		glBindVertexArray(streamArray);
+		glBindBuffer(GL_ARRAY_BUFFER, streamBuffer);
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices.data());
+		glDrawArrays(GL_LINES, 0, 2 * segments);
+	}));
+
+	// The strategies above bind through raw GL, which the renderer's state cache cannot see.
+	GLState::Invalidate();
+
+	// LineBatch falls back to unsynchronized mapping without GL 4.4.
+	uint32_t sections = (segments + lineBatch.getSegmentsPerSection() - 1) / lineBatch.getSegmentsPerSection();
+	PrintResult(lineBatch.isPersistent() ? "persistent mapped" : "unsynchronized map", segments, sections, Measure(options, [&]()
+	{
+		lineBatch.drawSegments(vertices);
+		lineBatch.flush();
+	}));
+
+	glDeleteVertexArrays(1, &staticArray);
+	glDeleteVertexArrays(1, &instancedArray);
+	glDeleteVertexArrays(1, &streamArray);
+	glDeleteBuffers(1, &staticBuffer);
+	glDeleteBuffers(1, &streamBuffer);
+
+	GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		LOG_ERROR("OpenGL error {:#x} during the benchmark", error);
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+struct BenchmarkOptions;
+
+// Draws the same random segments with each submission strategy and reports segments per
+// second, CPU submit time and GPU time, so the line path can be chosen from measurements.
+int RunLineBenchmark(const BenchmarkOptions& options);
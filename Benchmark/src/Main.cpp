@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Benchmark.h"
+#include "CompareRuns.h"
+#include "DecodeTrace.h"
+#include "LineBenchmark.h"
+#include "SceneBenchmark.h"
+#include "Logger/Logger.h"
+
+
+static void PrintUsage()
+{
+	std::printf(
+		"usage: Benchmark <mode> [options]\n"
+		"       Benchmark compare <base.csv> <candidate.csv> [--threshold PCT]\n"
+		"       Benchmark trace <events.trace>\n"
+		"  run from the Lines directory so res/ resolves\n"
+		"modes:\n"
+		"  scene             render the application scene along a scripted camera path\n"
+		"  lines             compare line submission strategies on random segments\n"
+		"  compare           diff two telemetry files from \"Lines --benchmark N --telemetry file.csv\"\n"
+		"  trace             print a binary event trace saved by Lines as text\n"
+		"options:\n"
+		"  --frames N        measured frames (default 600)\n"
+		"  --warmup N        frames rendered before measuring (default 60)\n"
+		"  --size WxH        framebuffer size (default 1280x720)\n"
+		"  --max-p95 MS      exit with 1 when the p95 frame time is above MS\n"
+		"  --infinite-grid   draw the procedural grid instead of thick lines\n"
+		"  --segments N      random segments for lines, plain or in millions like 2M (default 1M)\n"
+		"  --threshold PCT   compare exits with 1 when a cpu or gpu p95 regressed by more than PCT\n"
+		"  --log SPEC        log verbosity per category, e.g. shader=trace,gl=warn\n");
+}
+
+int main(int argc, char** argv)
+{
+	Log::Init();
+
+	BenchmarkOptions options;
+	if (argc >= 4 && std::strcmp(argv[1], "compare") == 0)
+	{
+		if (!options.parse(argc, argv, 4))
+		{
+			PrintUsage();
+			return 2;
+		}
+		return RunCompare(argv[2], argv[3], options);
+	}
+
+	if (argc == 3 && std::strcmp(argv[1], "trace") == 0)
+		return RunDecodeTrace(argv[2]);
+
+	if (argc < 2 || !options.parse(argc, argv, 2))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	if (std::strcmp(argv[1], "scene") == 0)
+		return RunSceneBenchmark(options);
+	if (std::strcmp(argv[1], "lines") == 0)
+		return RunLineBenchmark(options);
+
+	LOG_ERROR("Unknown benchmark mode {}", argv[1]);
+	PrintUsage();
+	return 2;
+}
@@ -0,0 +1,78 @@
+#include "SceneBenchmark.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "Window.h"
+#include "ShaderBatch.h"
+#include "Logger/Logger.h"
+#include "Profiler/CpuProfiler.h"
+#include "Renderer/Camera.h"
+#include "Renderer/Scene.h"
+
+
+// Camera orbit for frame t in [0, 1): one full turn while bobbing twice, so every run sees
+// the grid edge-on, from above and close to the spiral.
+static glm::vec3 CameraPath(float t)
+{
+	float angle = glm::two_pi<float>() * t;
+	return { 12.f * glm::cos(angle), 2.f + 4.f * glm::sin(2.f * angle), 12.f * glm::sin(angle) };
+}
+
+int RunSceneBenchmark(const BenchmarkOptions& options)
+{
+	HeadlessContext context(options.width, options.height);
+	if (!context.isValid())
+		return 2;
+
+	ShaderBatch shaders;
+	Scene scene(shaders);
+	shaders.finish();
+
+	SceneSettings settings;
+	settings.infiniteGrid = options.infiniteGrid;
+
+	Camera camera(glm::radians(75.f), 0.1f, 100.f, glm::vec2((float)options.width, (float)options.height));
+	glViewport(0, 0, options.width, options.height);
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(options.frames);
+
+	uint32_t total = options.warmup + options.frames;
+	for (uint32_t i = 0; i < total; i++)
+	{
+		uint64_t start = CpuProfiler::Now();
+
+		camera.lookAt(CameraPath((float)i / total), glm::vec3(0.f));
+
+		glClearColor(0.f, 0.f, 0.f, 1.f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		scene.draw(camera, settings);
+		context.getWindow()->swapBuffers();
+
+		// A software rasterizer may defer the work; waiting here makes the sample cover the whole frame.
+		glFinish();
+
+		if (i >= options.warmup)
+			frameTimes.push_back((CpuProfiler::Now() - start) * 1e-6);
+	}
+
+	GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		LOG_ERROR("OpenGL error {:#x} during the benchmark", error);
+		return 2;
+	}
+
+	Percentiles percentiles = Percentiles::Compute(frameTimes);
+	std::printf("scene %dx%d, %s grid\n", options.width, options.height, options.infiniteGrid ? "infinite" : "thick");
+	PrintPercentiles("frame", percentiles);
+
+	if (options.maxP95 > 0.f && percentiles.p95 > options.maxP95)
+	{
+		LOG_ERROR("p95 frame time {:.3f} ms exceeds the {:.3f} ms budget", percentiles.p95, options.maxP95);
+		return 1;
+	}
+	return 0;
+}
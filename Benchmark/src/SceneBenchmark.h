@@ -0,0 +1,7 @@
+#pragma once
+
+struct BenchmarkOptions;
+
+// Renders the application scene along a scripted orbit and reports frame-time percentiles.
+// Returns the process exit code: non-zero when the p95 gate fails.
+int RunSceneBenchmark(const BenchmarkOptions& options);
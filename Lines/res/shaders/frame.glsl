@@ -0,0 +1,10 @@
+// Camera data, rewritten by Scene only when the camera changes (see UniformBuffer.h).
+layout(std140) uniform FrameData
+{
+    mat4 u_View;
+    mat4 u_Projection;
+    mat4 u_ViewProj;
+    mat4 u_InvViewProj;
+    vec4 u_CameraPos;
+    vec2 u_Viewport;
+};
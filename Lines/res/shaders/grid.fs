@@ -0,0 +1,49 @@
+#version 330 core
+
+in vec3 v_NearPoint;
+in vec3 v_FarPoint;
+
+out vec4 fragColor;
+
+#include "frame.glsl"
+
+uniform vec3 u_Color;
+uniform float u_Height;
+uniform float u_MinorSpacing;
+uniform float u_MajorSpacing;
+uniform float u_FadeDistance;
+
+// Anti-aliased line coverage for one grid level. The level fades out once its
+// cells shrink to a few pixels, so distant minor lines never turn into noise.
+float gridLevel(vec2 coord, float spacing)
+{
+    vec2 scaled = coord / spacing;
+    vec2 derivative = fwidth(scaled);
+    vec2 line = abs(fract(scaled - 0.5) - 0.5) / derivative;
+    float coverage = 1.0 - min(min(line.x, line.y), 1.0);
+
+    float cellsPerPixel = max(derivative.x, derivative.y);
+    return coverage * (1.0 - smoothstep(0.15, 0.5, cellsPerPixel));
+}
+
+void main()
+{
+    float t = (u_Height - v_NearPoint.y) / (v_FarPoint.y - v_NearPoint.y);
+    if (t <= 0.0)
+        discard;
+
+    vec3 position = v_NearPoint + t * (v_FarPoint - v_NearPoint);
+
+    float minor = gridLevel(position.xz, u_MinorSpacing);
+    float major = gridLevel(position.xz, u_MajorSpacing);
+    float fade = 1.0 - smoothstep(0.25 * u_FadeDistance, u_FadeDistance, distance(position.xz, u_CameraPos.xz));
+
+    float alpha = max(0.5 * minor, major) * fade;
+    if (alpha <= 0.0)
+        discard;
+
+    vec4 clip = u_ViewProj * vec4(position, 1.0);
+    gl_FragDepth = 0.5 * (clip.z / clip.w) + 0.5;
+
+    fragColor = vec4(u_Color, alpha);
+}
@@ -0,0 +1,27 @@
+#version 330 core
+
+// Full-screen quad; each corner is unprojected onto the near and far planes so
+// the fragment shader can intersect the view ray with the ground plane.
+const vec2 c_Corners[4] = vec2[4](
+    vec2(-1.0, -1.0), vec2(1.0, -1.0),
+    vec2(-1.0,  1.0), vec2(1.0,  1.0)
+);
+
+out vec3 v_NearPoint;
+out vec3 v_FarPoint;
+
+#include "frame.glsl"
+
+vec3 unproject(vec2 xy, float z)
+{
+    vec4 point = u_InvViewProj * vec4(xy, z, 1.0);
+    return point.xyz / point.w;
+}
+
+void main()
+{
+    vec2 corner = c_Corners[gl_VertexID];
+    v_NearPoint = unproject(corner, -1.0);
+    v_FarPoint = unproject(corner, 1.0);
+    gl_Position = vec4(corner, 0.0, 1.0);
+}
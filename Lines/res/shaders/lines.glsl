@@ -0,0 +1,26 @@
+#include "frame.glsl"
+
+// Pixels added around a line so the fragment shader has room to fade the edge.
+const float c_Feather = 1.0;
+
+// Clips a segment against the near plane so both endpoints project in front of the camera.
+// Returns false when the whole segment is behind it.
+bool clipSegment(inout vec4 clipStart, inout vec4 clipEnd)
+{
+    float nearStart = clipStart.z + clipStart.w;
+    float nearEnd = clipEnd.z + clipEnd.w;
+    if (nearStart < 0.0 && nearEnd < 0.0)
+        return false;
+
+    if (nearStart < 0.0)
+        clipStart = mix(clipStart, clipEnd, nearStart / (nearStart - nearEnd));
+    if (nearEnd < 0.0)
+        clipEnd = mix(clipEnd, clipStart, nearEnd / (nearEnd - nearStart));
+    return true;
+}
+
+// Clip space to pixels, relative to the viewport centre.
+vec2 toScreen(vec4 clip)
+{
+    return clip.xy / clip.w * 0.5 * u_Viewport;
+}
@@ -0,0 +1,58 @@
+#version 330 core
+
+in vec3 v_Color;
+noperspective in vec2 v_Local;
+flat in float v_Length;
+flat in vec3 v_Prev;
+flat in vec3 v_Next;
+
+out vec4 fragColor;
+
+uniform float u_Width;
+uniform float u_MiterLimit;
+uniform int u_Join;     // 0 = miter, 1 = bevel, 2 = round
+uniform int u_Cap;      // 0 = butt, 1 = square, 2 = round
+
+// Shapes one end of the segment. `q` is measured from that end with x pointing into the
+// segment; `neighbour` is the adjacent segment's direction towards the joint in the same frame.
+float shapeEnd(float dist, vec2 q, vec3 neighbour, float halfWidth)
+{
+    if (neighbour.z == 0.0)
+    {
+        if (u_Cap == 0) return max(dist, -q.x);
+        if (u_Cap == 1) return max(dist, -q.x - halfWidth);
+        return q.x >= 0.0 ? dist : length(q) - halfWidth;
+    }
+
+    // The joint line through the shared point splits the join between both segments.
+    vec2 tangent = neighbour.xy + vec2(1.0, 0.0);
+    tangent = dot(tangent, tangent) > 1e-6 ? normalize(tangent) : vec2(0.0, 1.0);
+    if (dot(q, tangent) < 0.0)
+        discard;
+
+    if (u_Join == 2)
+        return min(q.x >= 0.0 ? dist : 1e9, length(q) - halfWidth);
+
+    vec2 miter = vec2(-tangent.y, tangent.x);
+    if (u_Join == 0 && miter.y * u_MiterLimit >= 1.0)
+        return dist;
+
+    // A left turn (neighbour below the x axis) puts the outer corner on the right side.
+    vec2 outer = neighbour.y <= 0.0 ? -miter : miter;
+    return max(dist, dot(q, outer) - halfWidth * miter.y);
+}
+
+void main()
+{
+    float halfWidth = 0.5 * u_Width;
+
+    float dist = abs(v_Local.y) - halfWidth;
+    dist = shapeEnd(dist, v_Local, v_Prev, halfWidth);
+    dist = shapeEnd(dist, vec2(v_Length - v_Local.x, -v_Local.y), v_Next, halfWidth);
+
+    float coverage = clamp(0.5 - dist, 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+
+    fragColor = vec4(v_Color, 0.8 * coverage);
+}
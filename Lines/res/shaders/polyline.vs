@@ -0,0 +1,78 @@
+#version 330 core
+
+// One instance per segment. The previous and next points are read as extra
+// per-instance attributes from the same buffer, so joins need no CPU work.
+const vec2 c_Corners[4] = vec2[4](
+    vec2(0.0, -1.0), vec2(1.0, -1.0),
+    vec2(0.0,  1.0), vec2(1.0,  1.0)
+);
+
+layout(location = 0) in vec3 a_Prev;
+layout(location = 1) in vec3 a_Start;
+layout(location = 2) in vec3 a_Color;
+layout(location = 3) in vec3 a_End;
+layout(location = 4) in vec3 a_Next;
+
+out vec3 v_Color;
+noperspective out vec2 v_Local;
+flat out float v_Length;
+flat out vec3 v_Prev;
+flat out vec3 v_Next;
+
+#include "lines.glsl"
+
+uniform float u_Width;
+uniform float u_MiterLimit;
+
+// Direction of a neighbouring segment in the local (along, across) frame; z flags whether it exists.
+vec3 neighbour(vec3 point, vec2 joint, bool incoming, vec2 along, vec2 across)
+{
+    vec4 clip = u_ViewProj * vec4(point, 1.0);
+    if (clip.w <= 0.0)
+        return vec3(0.0);
+
+    vec2 delta = incoming ? joint - toScreen(clip) : toScreen(clip) - joint;
+    if (dot(delta, delta) < 1e-6)
+        return vec3(0.0);
+
+    delta = normalize(delta);
+    return vec3(dot(delta, along), dot(delta, across), 1.0);
+}
+
+void main()
+{
+    vec4 clipStart = u_ViewProj * vec4(a_Start, 1.0);
+    vec4 clipEnd = u_ViewProj * vec4(a_End, 1.0);
+
+    if (!clipSegment(clipStart, clipEnd))
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    vec2 screenStart = toScreen(clipStart);
+    vec2 screenEnd = toScreen(clipEnd);
+
+    vec2 along = screenEnd - screenStart;
+    float len = length(along);
+    along = len > 1e-4 ? along / len : vec2(1.0, 0.0);
+    vec2 across = vec2(-along.y, along.x);
+
+    // Miter tips reach at most u_MiterLimit half-widths past the joint before falling back to bevel.
+    float halfWidth = 0.5 * u_Width;
+    float extent = halfWidth * max(u_MiterLimit, 1.0) + c_Feather;
+
+    vec2 corner = c_Corners[gl_VertexID];
+    vec2 local = vec2(mix(-extent, len + extent, corner.x), corner.y * (halfWidth + c_Feather));
+
+    vec4 clip = mix(clipStart, clipEnd, clamp(local.x / max(len, 1e-4), 0.0, 1.0));
+    vec2 screen = screenStart + along * local.x + across * local.y;
+    clip.xy = screen / (0.5 * u_Viewport) * clip.w;
+
+    gl_Position = clip;
+    v_Color = a_Color;
+    v_Local = local;
+    v_Length = len;
+    v_Prev = neighbour(a_Prev, screenStart, true, along, across);
+    v_Next = neighbour(a_Next, screenEnd, false, along, across);
+}
@@ -5,11 +5,12 @@ layout(location = 1) in vec3 a_Color;
 
 out vec3 v_Color;
 
-uniform mat4 u_MVP;
+#include "frame.glsl"
+
 uniform mat4 u_Model;
 
 void main()
 {
-    gl_Position = u_MVP * u_Model * vec4(a_Position, 1.0);
+    gl_Position = u_ViewProj * u_Model * vec4(a_Position, 1.0);
     v_Color = a_Color;
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#version 330 core
+
+in vec3 v_Color;
+noperspective in float v_Distance;
+#ifdef DASHED
+noperspective in float v_Along;
+#endif
+
+out vec4 fragColor;
+
+uniform float u_Width;
+#ifdef DASHED
+uniform float u_DashLength;
+#endif
+
+void main()
+{
+    // Pixel coverage of a box filter against the line's half width.
+    float coverage = clamp(0.5 * u_Width + 0.5 - abs(v_Distance), 0.0, 1.0);
+#ifdef DASHED
+    // Dashes and gaps of equal length, measured in pixels along the segment.
+    float dash = mod(v_Along, 2.0 * u_DashLength);
+    coverage *= clamp(min(dash, u_DashLength - dash) + 0.5, 0.0, 1.0);
+#endif
+    if (coverage <= 0.0)
+        discard;
+
+    fragColor = vec4(v_Color, 0.8 * coverage);
+}
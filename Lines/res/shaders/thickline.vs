@@ -0,0 +1,56 @@
+#version 330 core
+
+// One instance per segment. The four quad corners come from gl_VertexID:
+// x selects the endpoint, y the side of the line.
+const vec2 c_Corners[4] = vec2[4](
+    vec2(0.0, -1.0), vec2(1.0, -1.0),
+    vec2(0.0,  1.0), vec2(1.0,  1.0)
+);
+
+layout(location = 0) in vec3 a_Start;
+layout(location = 1) in vec3 a_Color;
+layout(location = 2) in vec3 a_End;
+
+out vec3 v_Color;
+noperspective out float v_Distance;
+#ifdef DASHED
+noperspective out float v_Along;
+#endif
+
+#include "lines.glsl"
+
+uniform float u_Width;
+
+void main()
+{
+    vec4 clipStart = u_ViewProj * vec4(a_Start, 1.0);
+    vec4 clipEnd = u_ViewProj * vec4(a_End, 1.0);
+
+    if (!clipSegment(clipStart, clipEnd))
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    vec2 halfViewport = 0.5 * u_Viewport;
+    vec2 screenStart = toScreen(clipStart);
+    vec2 screenEnd = toScreen(clipEnd);
+
+    vec2 direction = screenEnd - screenStart;
+    direction = dot(direction, direction) > 1e-8 ? normalize(direction) : vec2(1.0, 0.0);
+    vec2 normal = vec2(-direction.y, direction.x);
+
+    vec2 corner = c_Corners[gl_VertexID];
+    float halfWidth = 0.5 * u_Width + c_Feather;
+    vec2 offset = normal * corner.y * halfWidth + direction * (2.0 * corner.x - 1.0) * c_Feather;
+
+    vec4 clip = mix(clipStart, clipEnd, corner.x);
+    clip.xy += offset / halfViewport * clip.w;
+
+    gl_Position = clip;
+    v_Color = a_Color;
+    v_Distance = corner.y * halfWidth;
+#ifdef DASHED
+    v_Along = mix(-c_Feather, length(screenEnd - screenStart) + c_Feather, corner.x);
+#endif
+}
@@ -1,55 +1,61 @@
 #include <glad/glad.h>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
 
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
 #include "Application.h"
+#include "GLDebug.h"
 #include "Logger/Logger.h"
+#include "Profiler/TraceLog.h"
+#include "Renderer/RenderStats.h"
 
 
 constexpr int32_t INITIAL_WIDTH = 1600;
 constexpr int32_t INITIAL_HEIGHT = 1200;
 
-#define APP_ASSERT(expression, ...) if (!(expression)) { LOG_ERROR(__VA_ARGS__); __debugbreak(); }
+// Flushes first: release builds log asynchronously and the message would die with the process.
+#define APP_ASSERT(expression, ...) if (!(expression)) { LOG_ERROR(__VA_ARGS__); Log::Flush(); DEBUG_BREAK(); }
 
 static void glfw_error_callback(int errorCode, const char* description);
 
-Application* Application::s_App = new Application();
+Application* Application::s_App = nullptr;
 
 Application::Application()
-	: m_Running{ false },
-	m_Camera {glm::identity<glm::mat4>()},
-	m_Rotate {glm::identity<glm::mat4>()},
-	m_HorizontalDirection { glm::identity<glm::mat4>() },
-	m_VerticalDirection {glm::identity<glm::mat4>()},
-	m_Pers { glm::perspective(glm::radians(75.f), (float)INITIAL_WIDTH / INITIAL_HEIGHT, 0.1f, 1000.f)},
-	m_MVP {glm::identity<glm::mat4>()},
-	m_VerticalRadian {0.f},
-	m_HorizontalRadian {0.f}
+	: m_Telemetry { nullptr },
+	m_Camera { glm::radians(75.f), 0.1f, 100.f, glm::vec2((float)INITIAL_WIDTH, (float)INITIAL_HEIGHT) },
+	m_Settings {},
+	m_Running{ false }
 {
+	s_App = this;
+	CpuProfiler::SetThreadName("Main");
 	m_Window = new Window(INITIAL_WIDTH, INITIAL_HEIGHT, "Draw Lines");
 	m_Window->makeContexCurrent();
 
 	APP_ASSERT(gladLoadGLLoader((GLADloadproc)glfwGetProcAddress), "Failed to initialize Glad");
+#ifdef LINES_DEBUG
+	GLDebug::Init(DebugSeverity::Low);
+#endif
 	setup();
 }
 
 Application::~Application()
 {
-	glDeleteBuffers(1, &m_Box);
-	glDeleteBuffers(1, &m_BoxBuffer);
-	glDeleteBuffers(1, &m_BoxIndicesBuffer);
-
-	glDeleteBuffers(1, &m_Floor);
-	glDeleteBuffers(1, &m_FloorBuffer);
-	glDeleteBuffers(1, &m_FloorIndicesBuffer);
+	// The watcher holds pointers to the shaders, so it goes first. The window goes last because
+	// everything else still needs its GL context.
+	delete m_ShaderWatcher;
+	delete m_Scene;
+	delete m_GpuProfiler;
+	delete m_Telemetry;
+	delete m_ShaderBatch;
 
 	delete m_Window;
-	delete m_Shader;
 
-	delete s_App;
+	s_App = nullptr;
 }
 
 void Application::setup()
@@ -60,6 +66,7 @@ void Application::setup()
 	glfwSetKeyCallback(m_Window->getInstance(), OnKeyPressed);
 	glfwSetMouseButtonCallback(m_Window->getInstance(), OnMouseButton);
 	glfwSetCursorPosCallback(m_Window->getInstance(), OnCursorPos);
+	glfwSetWindowFocusCallback(m_Window->getInstance(), OnWindowFocus);
 	glfwSetFramebufferSizeCallback(m_Window->getInstance(), OnFramebufferResize);
 
 	ImGui::CreateContext();
@@ -79,107 +86,61 @@ void Application::setup()
 	ImGui_ImplGlfw_InitForOpenGL(m_Window->getInstance(), true);
 	ImGui_ImplOpenGL3_Init("#version 330");
 
-	m_Shader = new Shader("res/shaders/shader.vs", "res/shaders/shader.fs");
-	m_Shader->bind();
+	m_ShaderBatch = new ShaderBatch();
+	m_Scene = new Scene(*m_ShaderBatch);
+	m_GpuProfiler = new GpuProfiler();
 
 	int32_t width, height;
 	glfwGetFramebufferSize(m_Window->getInstance(), &width, &height);
-	m_Pers = glm::perspective(glm::radians(75.0f), (float)width / height, 0.1f, 100.0f);
-	m_Camera = glm::translate(m_Camera, glm::vec3(0.f, 0.f, -10.f));
-	
-	glEnable(GL_DEPTH_TEST);
-
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	prepareData();
-}
-
-void Application::prepareData()
-{
-	float boxVertices[] = {
-		// Positions			// Colors
-		-1.0f, -1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
-		 1.0f, -1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
-		 1.0f,  1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
-		-1.0f,  1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
-
-		-1.0f, -1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
-		 1.0f, -1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
-		 1.0f,  1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
-		-1.0f,  1.0f, -1.0f,	0.2f, 0.8f, 0.5f
-	};
-
-	uint32_t boxIndices[] = {
-		0, 1, 2,	0, 2, 3,
-		4, 5, 6,	4, 6, 7
-	};
-
-	glGenVertexArrays(1, &m_Box);
-	glGenBuffers(1, &m_BoxBuffer);
-	glGenBuffers(1, &m_BoxIndicesBuffer);
-
-	glBindVertexArray(m_Box);
-
-	glBindBuffer(GL_ARRAY_BUFFER, m_BoxBuffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(boxVertices), boxVertices, GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BoxIndicesBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(boxIndices), boxIndices, GL_STATIC_DRAW);
-
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 0);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	m_Camera.setViewport(glm::vec2((float)width, (float)height));
+	m_Camera.setPosition(glm::vec3(0.f, 0.f, 10.f));
 
 	glfwSwapInterval(1);
+	GL_CHECK("Application::setup");
 
-	glGenVertexArrays(1, &m_Floor);
-	glGenBuffers(1, &m_FloorBuffer);
-	glGenBuffers(1, &m_FloorIndicesBuffer);
-
-	float m_FloorVertices[] = {
-		-1.0f, -5.0f, 0.0f,		 .7f, .7f, .7f,
-		 1.0f, -5.0f, 0.0f,		 .7f, .7f, .7f
-	};
-
-	uint32_t m_FloorIndices[] = {
-		0, 1
-	};
-
-	glBindVertexArray(m_Floor);
-	glBindBuffer(GL_ARRAY_BUFFER, m_FloorBuffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(m_FloorVertices), m_FloorVertices, GL_STATIC_DRAW);
-
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 0);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_FloorIndicesBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(m_FloorIndices), m_FloorIndices, GL_STATIC_DRAW);
-
-	APP_ASSERT(glGetError() == GL_NO_ERROR, "There are some errors: {}", glGetError());
+	m_ShaderWatcher = new ShaderWatcher("res/shaders");
+	for (Shader* shader : m_ShaderBatch->getShaders())
+	{
+		m_ShaderWatcher->watch(shader);
+	}
 }
 
 void Application::run()
 {
-	glm::mat4 model = glm::identity<glm::mat4>();
-
 	bool show_demo_window = true;
 	ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
 	m_Running = true;
+	waitForShaders();
+
+	uint32_t frameIndex = 0;
+	uint64_t cameraVersion = 0;
 	while (m_Running)
 	{
+		CpuProfiler::BeginFrame();
+		PROFILE_SCOPE("Frame");
+		uint64_t frameStart = CpuProfiler::Now();
+		RenderStats renderStats = RenderStats::Get();
+		RenderStats::Reset();
+		TRACE_EVENT("frame {} draws {} primitives {} state changes {} uploaded {} B", frameIndex++, renderStats.drawCalls,
+			renderStats.primitives, renderStats.stateChanges, renderStats.bytesUploaded);
+
+		UniformStats uniformStats = Shader::GetUniformStats();
+		Shader::ResetUniformStats();
+
+		m_ShaderWatcher->update();
 		processInput();
+		m_GpuProfiler->beginFrame();
 
 		glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
-		ImGui::NewFrame();
+		{
+			PROFILE_SCOPE("ImGui::NewFrame");
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+			ImGui::NewFrame();
+		}
 
 		ImGuiIO& io = ImGui::GetIO();
 		{
@@ -187,65 +148,137 @@ void Application::run()
 			ImGui::Text("Background Color: ");                      
 			ImGui::ColorEdit3("clear color", (float*)&clear_color);
 			ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+			ImGui::Text("Uniform uploads: %u (skipped %u)", uniformStats.uploads, uniformStats.skipped);
+
+			LogMetrics logMetrics = Log::GetMetrics();
+			ImGui::Text("Log (%s): %llu enqueued, %llu dropped", logMetrics.async ? "async" : "sync",
+				(unsigned long long)logMetrics.enqueued, (unsigned long long)logMetrics.dropped);
+			if (logMetrics.async)
+				ImGui::Text("Log queue: %u (peak %u)", logMetrics.queueDepth, logMetrics.peakQueueDepth);
+
+			bool tracing = TraceLog::IsEnabled();
+			if (ImGui::Checkbox("Event trace", &tracing))
+				TraceLog::SetEnabled(tracing);
+			ImGui::SameLine();
+			if (ImGui::Button("Save Event Trace"))
+				TraceLog::Save("cache/events.trace");
 			ImGui::End();
 		}
+		m_GpuProfiler->drawPanel();
+		CpuProfiler::DrawPanel();
+		RenderStats::DrawOverlay(renderStats);
 
-		static float rotateAngleX = 23.f;// = (float)glfwGetTime();
-		static float rotateAngleY = 54.f;// = (float)glfwGetTime();
-		static float rotateAngleZ = 23.f;// = (float)glfwGetTime();
 		{
 			ImGui::Begin("Draw Lines");
 			ImGui::Text("Set the object rotation angle in degrees");
-			ImGui::SliderFloat("X Rotation", &rotateAngleX, 0.0f, 360.f);
+			ImGui::SliderFloat("X Rotation", &m_Settings.boxRotation.x, 0.0f, 360.f);
 			ImGui::Text("Set the object rotation angle in degrees");
-			ImGui::SliderFloat("Y Rotation", &rotateAngleY, 0.0f, 360.f);
+			ImGui::SliderFloat("Y Rotation", &m_Settings.boxRotation.y, 0.0f, 360.f);
 			ImGui::Text("Set the object rotation angle in degrees");
-			ImGui::SliderFloat("Z Rotation", &rotateAngleZ, 0.0f, 360.f);
+			ImGui::SliderFloat("Z Rotation", &m_Settings.boxRotation.z, 0.0f, 360.f);
+			ImGui::Checkbox("Infinite Grid", &m_Settings.infiniteGrid);
+			ImGui::SliderFloat("Line Width", &m_Settings.lineWidth, 1.f, 10.f);
+			ImGui::Checkbox("Dashed Grid", &m_Settings.dashed);
+			ImGui::Combo("Join", (int*)&m_Settings.join, "Miter\0Bevel\0Round\0");
+			ImGui::Combo("Cap", (int*)&m_Settings.cap, "Butt\0Square\0Round\0");
 			ImGui::End();
 		}
 
 
-		m_Rotate = glm::rotate(glm::mat4(1.f), m_VerticalRadian, glm::vec3(1.f, 0.f, 0.f))
-			* glm::rotate(glm::mat4(1.f), m_HorizontalRadian, glm::vec3(0.f, 1.f, 0.f));
-		m_MVP = m_Pers * m_Rotate * m_Camera;
-		m_Shader->setUniformMat4("u_MVP", m_MVP);
+		if (m_Telemetry)
+		{
+			// Circles the origin from the starting position, always facing the scene.
+			float angle = glm::two_pi<float>() * m_Telemetry->getSamples().size() / m_Telemetry->getFrameCount();
+			m_Camera.lookAt(10.f * glm::vec3(glm::sin(angle), 0.f, glm::cos(angle)), glm::vec3(0.f));
+		}
+
+		if (m_Camera.getVersion() != cameraVersion)
+		{
+			const glm::vec3& position = m_Camera.getPosition();
+			TRACE_EVENT("camera ({:.3f}, {:.3f}, {:.3f}) yaw {:.4f} pitch {:.4f}", position.x, position.y, position.z,
+				m_Camera.getYaw(), m_Camera.getPitch());
+			cameraVersion = m_Camera.getVersion();
+		}
+		m_Scene->draw(m_Camera, m_Settings, m_GpuProfiler);
 
-		glBindVertexArray(m_Box);
-		glm::mat4 rotate = glm::rotate(glm::mat4(1.0f), glm::radians(rotateAngleX), glm::vec3(1.0f, 0.0f, 0.0f))
-			* glm::rotate(glm::mat4(1.0f), glm::radians(rotateAngleY), glm::vec3(0.0f, 1.0f, 0.0f))
-			* glm::rotate(glm::mat4(1.0f), glm::radians(rotateAngleZ), glm::vec3(0.0f, 0.0f, 1.0f));
-		m_Shader->setUniformMat4("u_Model", rotate);
-		glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, nullptr);
+		GL_CHECK("scene draw");
 
-		glBindVertexArray(m_Floor);
-		m_Shader->setUniformMat4("u_Model", model);
-		glEnable(GL_LINE_SMOOTH);
-		glLineWidth(2.f);
-		for (int i = -20; i != 20; i++)
 		{
-			model = glm::mat4(1.f);
-			model = glm::scale(model, glm::vec3(20.f, 1.0f, 1.0f));
-			model = glm::translate(model, glm::vec3(0.f, 0.f,(float)i));
-			m_Shader->setUniformMat4("u_Model", model);
-			glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, nullptr);
+			PROFILE_SCOPE("ImGui::Render");
+			ImGui::Render();
+			{
+				GpuProfiler::Scope scope(m_GpuProfiler, "ImGui");
+				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			}
+			m_GpuProfiler->endFrame();
+
+			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+			{
+				GLFWwindow* backup_current_context = glfwGetCurrentContext();
+				ImGui::UpdatePlatformWindows();
+				ImGui::RenderPlatformWindowsDefault();
+				glfwMakeContextCurrent(backup_current_context);
+			}
 		}
 
-		for (int i = -20; i != 20; i++)
+		uint64_t swapStart = CpuProfiler::Now();
 		{
-			model = glm::mat4(1.f);
-			model = glm::scale(model, glm::vec3(1.f, 1.f, 20.f));
-			model = glm::rotate(model, glm::radians((float)90), glm::vec3(0.f, 1.f, 0.f));
-			model = glm::translate(model, glm::vec3(0.f, 0.f, (float)i));
-			m_Shader->setUniformMat4("u_Model", model);
-			glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, nullptr);
+			PROFILE_SCOPE("swapBuffers");
+			m_Window->swapBuffers();
 		}
 
-		APP_ASSERT(glGetError() == GL_NO_ERROR, "There are some errors!");
+		if (m_Telemetry)
+		{
+			const RenderStats& stats = RenderStats::Get();
+			uint32_t index = (uint32_t)m_Telemetry->getSamples().size();
+			float cpuMs = (swapStart - frameStart) * 1e-6f;
+			float swapMs = (CpuProfiler::Now() - swapStart) * 1e-6f;
+			m_Telemetry->record({ index, cpuMs, -1.f, swapMs, stats.drawCalls, stats.bytesUploaded });
+			m_Running = m_Running && !m_Telemetry->isComplete();
+		}
+
+		{
+			PROFILE_SCOPE("glfwPollEvents");
+			glfwPollEvents();
+		}
+	}
+
+	if (m_Telemetry)
+	{
+		m_GpuProfiler->finish();
+		m_Telemetry->writeCsv(m_TelemetryPath);
+		Telemetry::PrintSummary(m_Telemetry->getSamples());
+	}
+
+	ImGui_ImplOpenGL3_Shutdown();
+	ImGui_ImplGlfw_Shutdown();
+	ImGui::DestroyContext();
+}
+
+void Application::waitForShaders()
+{
+	// Keep presenting frames while the driver finishes compiling the programs submitted in setup().
+	while (m_Running && !m_ShaderBatch->poll())
+	{
+		// Keeps the input queue drained, and lets Escape quit during a long compile.
+		processInput();
+
+		glClearColor(0.f, 0.f, 0.f, 1.f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui_ImplGlfw_NewFrame();
+		ImGui::NewFrame();
+
+		uint32_t total = m_ShaderBatch->getTotalCount();
+		ImGui::Begin("Loading");
+		ImGui::Text("Compiling shaders: %u/%u", total - m_ShaderBatch->getPendingCount(), total);
+		ImGui::End();
 
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+		if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
 			GLFWwindow* backup_current_context = glfwGetCurrentContext();
 			ImGui::UpdatePlatformWindows();
@@ -256,31 +289,90 @@ void Application::run()
 		m_Window->swapBuffers();
 		glfwPollEvents();
 	}
+}
 
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
+void Application::enableBenchmark(uint32_t frameCount, const std::string& telemetryPath)
+{
+	delete m_Telemetry;
+	m_Telemetry = new Telemetry(frameCount);
+	m_TelemetryPath = telemetryPath;
+
+	m_GpuProfiler->setFrameCallback([this](uint32_t frame, float milliseconds) { m_Telemetry->setGpuTime(frame, milliseconds); });
+	glfwSwapInterval(0);
 }
 
-int main()
+int main(int argc, char** argv)
 {
-	Log::Init();
+	// [--benchmark N [--telemetry file.csv]] [--log category=level,...]
+	// [--log-sync | --log-async QUEUE_SIZE] [--log-overflow block|drop-oldest|drop-newest]
+	// [--trace file.trace]
+	LogSettings logSettings;
+#ifndef LINES_DEBUG
+	// Keeps console writes off the frame thread; debug builds stay synchronous so a message
+	// is on screen before the breakpoint that follows it.
+	logSettings.async = true;
+#endif
+	uint32_t benchmarkFrames = 0;
+	std::string telemetryPath = "cache/telemetry.csv";
+	const char* logSpec = nullptr;
+	const char* logOverflow = nullptr;
+	const char* tracePath = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--log-sync") == 0)
+			logSettings.async = false;
+		else if (i + 1 >= argc)
+			break;
+		else if (std::strcmp(argv[i], "--benchmark") == 0)
+			benchmarkFrames = (uint32_t)std::max(0, std::atoi(argv[++i]));
+		else if (std::strcmp(argv[i], "--telemetry") == 0)
+			telemetryPath = argv[++i];
+		else if (std::strcmp(argv[i], "--log") == 0)
+			logSpec = argv[++i];
+		else if (std::strcmp(argv[i], "--log-async") == 0)
+		{
+			logSettings.async = true;
+			logSettings.queueSize = (uint32_t)std::max(1, std::atoi(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--log-overflow") == 0)
+			logOverflow = argv[++i];
+		else if (std::strcmp(argv[i], "--trace") == 0)
+			tracePath = argv[++i];
+	}
+
+	// Parsed after the loop so a bad policy can be reported, but applied before Init().
+	bool overflowValid = !logOverflow || Log::ParseOverflow(logOverflow, logSettings.overflow);
+	Log::Init(logSettings);
+	if (!overflowValid)
+		LOG_ERROR("Unknown log overflow policy {}, expected block, drop-oldest or drop-newest", logOverflow);
+	if (logSpec)
+		Log::Configure(logSpec);
+
 	glfwSetErrorCallback(glfw_error_callback);
 	APP_ASSERT(glfwInit(), "Failed to initialize GLFW!");
 
+	Application* app = new Application();
 	LOG_INFO("The Current Version of OpenGL : {0}", (char*)glGetString(GL_VERSION));
 
-	Application* app = Application::GetApp();
+	if (benchmarkFrames > 0)
+	{
+		LOG_INFO("Benchmark mode: {} frames, telemetry to {}", benchmarkFrames, telemetryPath);
+		app->enableBenchmark(benchmarkFrames, telemetryPath);
+	}
 
 	app->run();
 
+	// Decode with "Benchmark trace <file>".
+	if (tracePath)
+		TraceLog::Save(tracePath);
+	delete app;
+	Log::Flush();
 	glfwTerminate();
 }
 
 static void glfw_error_callback(int errorCode, const char* description)
 {
-	LOG_ERROR("ERROR CODE: {0}", errorCode);
-	LOG_TRACE("DESCRIPTION\n\t {0}", description);
+	LOG_ERROR("ERROR CODE: {0}\n\t {1}", errorCode, description);
 }
 
 void Application::OnWindowClose(GLFWwindow* window)
@@ -291,87 +383,26 @@ void Application::OnWindowClose(GLFWwindow* window)
 
 void Application::OnKeyPressed(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
-	static bool isFullScreen = false;
-	Application* app = ((Application*)glfwGetWindowUserPointer(window))->GetApp();
-
-	if (action != GLFW_PRESS && action != GLFW_REPEAT) return;
-	switch (key)
-	{
-		case GLFW_KEY_ESCAPE:
-		{
-			app->m_Running = false;
-			break;
-		}
-		case GLFW_KEY_F:
-		{
-			if (mods != GLFW_MOD_CONTROL) break;
-
-			if (isFullScreen)
-			{
-				glfwSetWindowMonitor(window, nullptr, 300, 200, INITIAL_WIDTH, INITIAL_HEIGHT, 0);
-			}
-			else
-			{
-				GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-				const GLFWvidmode* vidmode = glfwGetVideoMode(monitor);
-				glfwSetWindowMonitor(window, monitor, 0, 0, vidmode->width, vidmode->height, vidmode->refreshRate);
-			}
-
-			isFullScreen = !isFullScreen;
-			break;
-		}
-	}
+	Application* app = (Application*)glfwGetWindowUserPointer(window);
+	app->m_Input.onKey(key, action, mods);
 }
 
 void Application::OnMouseButton(GLFWwindow* window, int button, int action, int mods)
 {
-	LOG_INFO("Button Event: [button:{0}, action:{1}, mods:{2}]", button, action, mods);
-
-	switch (button)
-	{
-		case GLFW_PRESS:
-		{
-
-		}
-		case GLFW_RELEASE:
-		{
-
-		}
-	}
+	Application* app = (Application*)glfwGetWindowUserPointer(window);
+	app->m_Input.onMouseButton(button, action, mods);
 }
 
 void Application::OnCursorPos(GLFWwindow* window, double xPos, double yPos)
 {
-	static float sencitiveness = 0.001f;
-	static float recordPosX = 0.f;
-	static float recordPosY = 0.f;
-	static Application* app = (Application*)glfwGetWindowUserPointer(window);
-	
-	int mouseLeftButtonState = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT);
-
-	switch (mouseLeftButtonState)
-	{
-		case GLFW_PRESS:
-		{
-			float xOffset = (float)xPos - recordPosX;
-			float yOffset = (float)yPos - recordPosY;
-
-			app->m_HorizontalRadian -= xOffset * sencitiveness;
-			app->m_VerticalRadian -= yOffset * sencitiveness;
-
-			app->m_HorizontalDirection = glm::rotate(glm::mat4(1.f), -app->m_HorizontalRadian, glm::vec3(0.f, 1.f, 0.f));
-			app->m_VerticalDirection = glm::rotate(glm::mat4(1.f), -app->m_VerticalRadian, glm::vec3(1.f, 0.f, 0.f));
-
-			break;
-		}
-		case GLFW_RELEASE:
-		{
-			break;
-		}
-	}
+	Application* app = (Application*)glfwGetWindowUserPointer(window);
+	app->m_Input.onCursorPos(xPos, yPos);
+}
 
-	recordPosX = (float)xPos;
-	recordPosY = (float)yPos;
+void Application::OnWindowFocus(GLFWwindow* window, int focused)
+{
+	Application* app = (Application*)glfwGetWindowUserPointer(window);
+	app->m_Input.onFocus(focused == GLFW_TRUE);
 }
 
 void Application::OnFramebufferResize(GLFWwindow* window, int width, int height)
@@ -380,78 +411,74 @@ void Application::OnFramebufferResize(GLFWwindow* window, int width, int height)
 	glViewport(0, 0, width, height);
 	if (width == 0 || height == 0) return;
 
-	app->m_Pers = glm::perspective(glm::radians(75.f), (float)width / height, 0.1f, 1000.f);
+	app->m_Camera.setViewport(glm::vec2((float)width, (float)height));
 }
 
 void Application::processInput()
 {
+	PROFILE_FUNCTION();
+	m_Input.update(CpuProfiler::Now());
 	processKey();
+	processCursor();
 }
 
 void Application::processKey()
 {
-	static constexpr int keys[6] = {
-	GLFW_KEY_A, GLFW_KEY_D,
-	GLFW_KEY_W, GLFW_KEY_X,
-	GLFW_KEY_J, GLFW_KEY_K
-	};
-
-	static constexpr float moveSpeed = 0.1f;
-	static glm::vec3 direction;
+	static bool isFullScreen = false;
 
-	for (int key : keys)
+	for (const InputEvent& event : m_Input.getEvents())
 	{
-		if (glfwGetKey(m_Window->getInstance(), key) != GLFW_PRESS) continue;
+		if (event.type != InputEvent::Type::Key || event.action != GLFW_PRESS) continue;
 
-		switch (key)
-		{
-		case GLFW_KEY_A:
+		switch (event.code)
 		{
-			LOG_INFO("KEY_A is Pressed");
-			direction = m_HorizontalDirection * glm::vec4(moveSpeed, 0.f, 0.f, 1.0f);
-			m_Camera = glm::translate(m_Camera, direction);
-			break;
-		}
-		case GLFW_KEY_D:
-		{
-			LOG_INFO("KEY_D is Pressed");
-			direction = m_HorizontalDirection * glm::vec4(-moveSpeed, 0.f, 0.f, 1.0f);
-			m_Camera = glm::translate(m_Camera, direction);
-			break;
-		}
-		case GLFW_KEY_W:
-		{
-			LOG_INFO("KEY_W is Pressed");
-			direction = m_HorizontalDirection * glm::vec4(0.f, 0.f, moveSpeed, 1.0f);
-			m_Camera = glm::translate(m_Camera, direction);
-			break;
-		}
-		case GLFW_KEY_X:
-		{
-			LOG_INFO("KEY_X is Pressed");
-			direction = m_HorizontalDirection * glm::vec4(0.f, 0.f, -moveSpeed, 1.0f);
-			m_Camera = glm::translate(m_Camera, direction);
-			break;
-		}
-		case GLFW_KEY_J:
+		case GLFW_KEY_ESCAPE:
 		{
-			LOG_INFO("KEY_J is Pressed");
-			direction = glm::vec3(0.f, moveSpeed, 0.f);
-			m_Camera = glm::translate(m_Camera, direction);
+			m_Running = false;
 			break;
 		}
-		case GLFW_KEY_K:
+		case GLFW_KEY_F:
 		{
-			LOG_INFO("KEY_K is Pressed");
-			direction = glm::vec3(0.f, -moveSpeed, 0.f);
-			m_Camera = glm::translate(m_Camera, direction);
+			if (event.mods != GLFW_MOD_CONTROL) break;
+
+			GLFWwindow* window = m_Window->getInstance();
+			if (isFullScreen)
+			{
+				glfwSetWindowMonitor(window, nullptr, 300, 200, INITIAL_WIDTH, INITIAL_HEIGHT, 0);
+			}
+			else
+			{
+				GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+				const GLFWvidmode* vidmode = glfwGetVideoMode(monitor);
+				glfwSetWindowMonitor(window, monitor, 0, 0, vidmode->width, vidmode->height, vidmode->refreshRate);
+			}
+
+			isFullScreen = !isFullScreen;
 			break;
 		}
 		}
 	}
 
+	// Units per second; the camera used to move 0.1 per frame, which is this at a vsynced 60 Hz.
+	static constexpr float moveSpeed = 6.f;
+
+	float right = m_Input.getHeldTime(GLFW_KEY_A) - m_Input.getHeldTime(GLFW_KEY_D);
+	float forward = m_Input.getHeldTime(GLFW_KEY_W) - m_Input.getHeldTime(GLFW_KEY_X);
+	float up = m_Input.getHeldTime(GLFW_KEY_J) - m_Input.getHeldTime(GLFW_KEY_K);
+	if (right == 0.f && forward == 0.f && up == 0.f) return;
+
+	// direction moves the world relative to the camera, so the camera itself moves the opposite way.
+	glm::mat4 heading = glm::rotate(glm::mat4(1.f), -m_Camera.getYaw(), glm::vec3(0.f, 1.f, 0.f));
+	glm::vec3 direction = glm::vec3(heading * glm::vec4(right, 0.f, forward, 0.f)) + glm::vec3(0.f, up, 0.f);
+	m_Camera.move(-moveSpeed * direction);
 }
 
 void Application::processCursor()
 {
+	static constexpr float sensitivity = 0.001f;
+
+	const glm::vec2& delta = m_Input.getMouseDelta();
+	if (delta.x == 0.f && delta.y == 0.f) return;
+
+	m_Camera.rotate(-delta.x * sensitivity, -delta.y * sensitivity);
 }
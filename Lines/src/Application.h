@@ -2,15 +2,14 @@
 #include <glm/glm.hpp>
 #include "Window.h"
 #include "Shader.h"
-
-class Camera
-{
-
-
-private:
-	float x, y, z;
-};
-
+#include "ShaderBatch.h"
+#include "ShaderWatcher.h"
+#include "Input/Input.h"
+#include "Renderer/Camera.h"
+#include "Renderer/Scene.h"
+#include "Profiler/CpuProfiler.h"
+#include "Profiler/GpuProfiler.h"
+#include "Profiler/Telemetry.h"
 
 class Application
 {
@@ -20,13 +19,18 @@ public:
 	inline static Application* GetApp() { return s_App; }
 
 	void setup();
-	void prepareData();
 	void run();
+	void waitForShaders();
+
+	// Renders frameCount frames along a fixed orbit without vsync, then writes per-frame
+	// telemetry to telemetryPath, prints a summary and quits.
+	void enableBenchmark(uint32_t frameCount, const std::string& telemetryPath);
 public:
 	static void OnWindowClose(GLFWwindow* window);
 	static void OnKeyPressed(GLFWwindow* window, int key, int scancode, int action, int mods);
 	static void OnMouseButton(GLFWwindow* window, int button, int action, int mods);
 	static void OnCursorPos(GLFWwindow* window, double xPos, double yPos);
+	static void OnWindowFocus(GLFWwindow* window, int focused);
 	static void OnFramebufferResize(GLFWwindow* window, int width,  int height);
 
 	void processInput();
@@ -34,21 +38,16 @@ public:
 	void processCursor();
 private:
 	Window* m_Window;
-	Shader* m_Shader;
+	ShaderBatch* m_ShaderBatch;
+	ShaderWatcher* m_ShaderWatcher;
+	Scene* m_Scene;
+	GpuProfiler* m_GpuProfiler;
+	Telemetry* m_Telemetry;
+	std::string m_TelemetryPath;
 private:
-	uint32_t m_Box, m_BoxBuffer, m_BoxIndicesBuffer;
-	uint32_t m_Floor, m_FloorBuffer, m_FloorIndicesBuffer;
-
-	glm::mat4 m_Camera;
-	glm::mat4 m_Rotate;
-	glm::mat4 m_HorizontalDirection;
-	glm::mat4 m_VerticalDirection;
-
-	float m_VerticalRadian;
-	float m_HorizontalRadian;
-
-	glm::mat4 m_Pers;
-	glm::mat4 m_MVP;
+	Input m_Input;
+	Camera m_Camera;
+	SceneSettings m_Settings;
 private:
 	bool m_Running;
 
@@ -0,0 +1,121 @@
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <atomic>
+#include <string_view>
+
+#include "Logger/Logger.h"
+
+
+bool GLDebug::s_CallbackEnabled = false;
+
+// The driver may call back from its own thread.
+static std::atomic<DebugSeverity> s_MinimumSeverity { DebugSeverity::Low };
+
+static const char* SourceName(GLenum source)
+{
+	switch (source)
+	{
+	case GL_DEBUG_SOURCE_API:				return "API";
+	case GL_DEBUG_SOURCE_WINDOW_SYSTEM:		return "Window System";
+	case GL_DEBUG_SOURCE_SHADER_COMPILER:	return "Shader Compiler";
+	case GL_DEBUG_SOURCE_THIRD_PARTY:		return "Third Party";
+	case GL_DEBUG_SOURCE_APPLICATION:		return "Application";
+	default:								return "Other";
+	}
+}
+
+static const char* TypeName(GLenum type)
+{
+	switch (type)
+	{
+	case GL_DEBUG_TYPE_ERROR:				return "Error";
+	case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:	return "Deprecated";
+	case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:	return "Undefined Behavior";
+	case GL_DEBUG_TYPE_PORTABILITY:			return "Portability";
+	case GL_DEBUG_TYPE_PERFORMANCE:			return "Performance";
+	case GL_DEBUG_TYPE_MARKER:				return "Marker";
+	default:								return "Other";
+	}
+}
+
+static DebugSeverity ToSeverity(GLenum severity)
+{
+	switch (severity)
+	{
+	case GL_DEBUG_SEVERITY_HIGH:	return DebugSeverity::High;
+	case GL_DEBUG_SEVERITY_MEDIUM:	return DebugSeverity::Medium;
+	case GL_DEBUG_SEVERITY_LOW:		return DebugSeverity::Low;
+	default:						return DebugSeverity::Notification;
+	}
+}
+
+static void APIENTRY OnDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei /*length*/, const GLchar* message, const void* /*userParam*/)
+{
+	DebugSeverity level = ToSeverity(severity);
+	if (level < s_MinimumSeverity.load(std::memory_order_relaxed))
+		return;
+
+	switch (level)
+	{
+	case DebugSeverity::High:	LOG_ERROR_TO(GL, "GL {} {} [{}]: {}", SourceName(source), TypeName(type), id, message); break;
+	case DebugSeverity::Medium:	LOG_WARN_TO(GL, "GL {} {} [{}]: {}", SourceName(source), TypeName(type), id, message); break;
+	case DebugSeverity::Low:	LOG_INFO_TO(GL, "GL {} {} [{}]: {}", SourceName(source), TypeName(type), id, message); break;
+	default:					LOG_TRACE_TO(GL, "GL {} {} [{}]: {}", SourceName(source), TypeName(type), id, message); break;
+	}
+}
+
+bool GLDebug::Init(DebugSeverity minimum)
+{
+	SetMinimumSeverity(minimum);
+
+	// glad only loads the 4.3 entry point on a 4.3 context; older contexts may still expose it as an extension.
+	PFNGLDEBUGMESSAGECALLBACKPROC debugMessageCallback = GLAD_GL_VERSION_4_3 ? glDebugMessageCallback : nullptr;
+	bool hasDebugOutput = debugMessageCallback != nullptr;
+	if (!debugMessageCallback)
+	{
+		int32_t count = {};
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (int32_t i = 0; i < count && !debugMessageCallback; i++)
+		{
+			std::string_view extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (extension == "GL_KHR_debug")
+			{
+				debugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)glfwGetProcAddress("glDebugMessageCallback");
+				hasDebugOutput = true;
+			}
+			else if (extension == "GL_ARB_debug_output")
+				debugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)glfwGetProcAddress("glDebugMessageCallbackARB");
+		}
+	}
+
+	if (!debugMessageCallback)
+	{
+		LOG_WARN_TO(GL, "KHR_debug is not available, falling back to glGetError checks");
+		return false;
+	}
+
+	// GL_DEBUG_OUTPUT is on by default in debug contexts; enabling it also covers the others.
+	// ARB_debug_output predates the enable and reports whenever the context is a debug one.
+	if (hasDebugOutput)
+		glEnable(GL_DEBUG_OUTPUT);
+	debugMessageCallback(OnDebugMessage, nullptr);
+	s_CallbackEnabled = true;
+	return true;
+}
+
+void GLDebug::SetMinimumSeverity(DebugSeverity minimum)
+{
+	s_MinimumSeverity.store(minimum, std::memory_order_relaxed);
+}
+
+void GLDebug::CheckErrors(const char* label)
+{
+	if (s_CallbackEnabled)
+		return;
+
+	for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+	{
+		LOG_ERROR_TO(GL, "GL error {:#x} at {}", error, label);
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+// Error checks in the frame loop only exist in Debug builds; Release and Dist compile
+// GL_CHECK to nothing, so the hot path never calls glGetError.
+#ifdef LINES_DEBUG
+	#define GL_CHECK(label) GLDebug::CheckErrors(label)
+#else
+	#define GL_CHECK(label) ((void)0)
+#endif
+
+enum class DebugSeverity : int32_t
+{
+	Notification, Low, Medium, High
+};
+
+// Routes driver messages from KHR_debug (core in GL 4.3) to the logger. Messages arrive
+// asynchronously through glDebugMessageCallback instead of being polled with glGetError.
+class GLDebug
+{
+public:
+	// Returns false when the context offers neither GL 4.3, KHR_debug nor ARB_debug_output.
+	static bool Init(DebugSeverity minimum);
+	static void SetMinimumSeverity(DebugSeverity minimum);
+
+	inline static bool IsCallbackEnabled() { return s_CallbackEnabled; }
+
+	// Logs and clears pending glGetError codes; does nothing while the callback reports errors.
+	static void CheckErrors(const char* label);
+private:
+	static bool s_CallbackEnabled;
+};
@@ -0,0 +1,129 @@
+#include "Input.h"
+#include <algorithm>
+
+#include "../Logger/Logger.h"
+#include "../Profiler/CpuProfiler.h"
+#include "../Profiler/TraceLog.h"
+
+
+Input::Input()
+	: m_Dropped { 0 }, m_ReportedDropped { 0 }, m_Down {}, m_DownSince {}, m_Held {},
+	m_Dragging { false }, m_HasCursor { false }, m_Cursor { 0.f }, m_MouseDelta { 0.f },
+	m_LastUpdate { 0 }, m_DeltaTime { 0.f }
+{
+	m_Events.reserve(64);
+}
+
+void Input::onKey(int32_t key, int32_t action, int32_t mods)
+{
+	push({ InputEvent::Type::Key, key, action, mods, glm::vec2(0.f), CpuProfiler::Now() });
+}
+
+void Input::onMouseButton(int32_t button, int32_t action, int32_t mods)
+{
+	push({ InputEvent::Type::MouseButton, button, action, mods, glm::vec2(0.f), CpuProfiler::Now() });
+}
+
+void Input::onCursorPos(double x, double y)
+{
+	push({ InputEvent::Type::CursorPos, 0, 0, 0, glm::vec2((float)x, (float)y), CpuProfiler::Now() });
+}
+
+void Input::onFocus(bool focused)
+{
+	push({ InputEvent::Type::Focus, 0, focused ? 1 : 0, 0, glm::vec2(0.f), CpuProfiler::Now() });
+}
+
+void Input::update(uint64_t now)
+{
+	PROFILE_FUNCTION();
+	uint64_t frameStart = m_LastUpdate ? m_LastUpdate : now;
+	m_DeltaTime = std::min((now - frameStart) * 1e-9f, MaxDeltaTime);
+	m_LastUpdate = now;
+
+	m_Events.clear();
+	m_Held.fill(0.f);
+	m_MouseDelta = glm::vec2(0.f);
+
+	InputEvent event;
+	while (m_Queue.pop(event))
+	{
+		switch (event.type)
+		{
+		case InputEvent::Type::Key:
+		{
+			TRACE_EVENT("key {} action {} mods {:#x}", event.code, event.action, event.mods);
+			m_Events.push_back(event);
+			if (event.code < 0 || event.code >= KeyCount) break;
+
+			if (event.action == GLFW_PRESS && !m_Down[event.code])
+			{
+				m_Down[event.code] = true;
+				m_DownSince[event.code] = event.time;
+			}
+			else if (event.action == GLFW_RELEASE && m_Down[event.code])
+			{
+				accumulate(event.code, frameStart, event.time);
+				m_Down[event.code] = false;
+			}
+			break;
+		}
+		case InputEvent::Type::MouseButton:
+		{
+			TRACE_EVENT("mouse button {} action {} mods {:#x}", event.code, event.action, event.mods);
+			m_Events.push_back(event);
+			if (event.code == GLFW_MOUSE_BUTTON_LEFT)
+				m_Dragging = event.action == GLFW_PRESS;
+			break;
+		}
+		case InputEvent::Type::CursorPos:
+		{
+			if (m_HasCursor && m_Dragging)
+				m_MouseDelta += event.position - m_Cursor;
+			m_Cursor = event.position;
+			m_HasCursor = true;
+			break;
+		}
+		case InputEvent::Type::Focus:
+		{
+			TRACE_EVENT("focus {}", event.action != 0);
+			// Releases that happen in another window are never delivered here.
+			if (event.action) break;
+			for (int32_t key = 0; key < KeyCount; key++)
+			{
+				if (!m_Down[key]) continue;
+				accumulate(key, frameStart, event.time);
+				m_Down[key] = false;
+			}
+			m_Dragging = false;
+			break;
+		}
+		}
+	}
+
+	for (int32_t key = 0; key < KeyCount; key++)
+	{
+		if (m_Down[key])
+			accumulate(key, frameStart, now);
+	}
+
+	uint32_t dropped = m_Dropped.load(std::memory_order_relaxed);
+	if (dropped != m_ReportedDropped)
+	{
+		LOG_WARN_TO(Input, "Input queue overflowed, {} events dropped so far", dropped);
+		m_ReportedDropped = dropped;
+	}
+}
+
+void Input::push(const InputEvent& event)
+{
+	if (!m_Queue.push(event))
+		m_Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Input::accumulate(int32_t key, uint64_t from, uint64_t until)
+{
+	from = std::max(from, m_DownSince[key]);
+	if (until > from)
+		m_Held[key] = std::min(m_Held[key] + (until - from) * 1e-9f, MaxDeltaTime);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <GLFW/glfw3.h>
+
+#include "SpscRing.h"
+
+struct InputEvent
+{
+	enum class Type : uint8_t
+	{
+		Key, MouseButton, CursorPos, Focus
+	};
+
+	Type type;
+	int32_t code;		// key or mouse button
+	int32_t action;		// GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT; 1 or 0 for focus
+	int32_t mods;
+	glm::vec2 position;	// cursor events only
+	uint64_t time;		// CpuProfiler::Now() when GLFW delivered it
+};
+
+// The GLFW callbacks only timestamp their event and push it onto a ring. update() drains
+// the ring once per frame. Key hold times are measured from those timestamps and cursor
+// motion is summed into one delta, so the per-frame work depends on how many events
+// arrived rather than on the frame rate.
+class Input
+{
+public:
+	static constexpr uint32_t QueueSize = 1024;
+	static constexpr int32_t KeyCount = GLFW_KEY_LAST + 1;
+	// Upper bound for one frame, so a stall does not turn a held key into a jump.
+	static constexpr float MaxDeltaTime = 0.1f;
+
+	Input();
+
+	// Producer side, called from the GLFW callbacks.
+	void onKey(int32_t key, int32_t action, int32_t mods);
+	void onMouseButton(int32_t button, int32_t action, int32_t mods);
+	void onCursorPos(double x, double y);
+	void onFocus(bool focused);
+
+	// Consumer side: drains the queue and accounts for the time since the previous update.
+	void update(uint64_t now);
+
+	// Key and mouse button events drained by the last update, in arrival order.
+	inline const std::vector<InputEvent>& getEvents() const { return m_Events; }
+	inline bool isKeyDown(int32_t key) const { return key >= 0 && key < KeyCount && m_Down[key]; }
+	// Seconds the key was held during the last update interval.
+	inline float getHeldTime(int32_t key) const { return key >= 0 && key < KeyCount ? m_Held[key] : 0.f; }
+	// Cursor movement in pixels while the left button was held, summed over the interval.
+	inline const glm::vec2& getMouseDelta() const { return m_MouseDelta; }
+	inline float getDeltaTime() const { return m_DeltaTime; }
+private:
+	void push(const InputEvent& event);
+	void accumulate(int32_t key, uint64_t from, uint64_t until);
+private:
+	SpscRing<InputEvent, QueueSize> m_Queue;
+	std::atomic<uint32_t> m_Dropped;
+	uint32_t m_ReportedDropped;
+
+	std::vector<InputEvent> m_Events;
+	std::array<bool, KeyCount> m_Down;
+	std::array<uint64_t, KeyCount> m_DownSince;
+	std::array<float, KeyCount> m_Held;
+
+	bool m_Dragging, m_HasCursor;
+	glm::vec2 m_Cursor, m_MouseDelta;
+
+	uint64_t m_LastUpdate;
+	float m_DeltaTime;
+};
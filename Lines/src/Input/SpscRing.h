@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Fixed-size queue for exactly one producer thread and one consumer thread. Each side owns
+// one index and only reads the other, so neither push nor pop takes a lock. Capacity must
+// be a power of two; a full ring rejects the push instead of overwriting.
+template<typename T, uint32_t Capacity>
+class SpscRing
+{
+	static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+public:
+	SpscRing()
+		: m_Items {}, m_Head { 0 }, m_Tail { 0 }
+	{
+	}
+
+	bool push(const T& item)
+	{
+		uint32_t head = m_Head.load(std::memory_order_relaxed);
+		if (head - m_Tail.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		m_Items[head & (Capacity - 1)] = item;
+		m_Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T& item)
+	{
+		uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+		if (tail == m_Head.load(std::memory_order_acquire))
+			return false;
+
+		item = m_Items[tail & (Capacity - 1)];
+		m_Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+private:
+	T m_Items[Capacity];
+	// Kept on separate cache lines so the two threads do not invalidate each other's index.
+	alignas(64) std::atomic<uint32_t> m_Head;
+	alignas(64) std::atomic<uint32_t> m_Tail;
+};
@@ -1,11 +1,169 @@
 #include "Logger.h"
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
 
+#include <spdlog/async.h>
+#include <spdlog/sinks/callback_sink.h>
 
-std::shared_ptr<spdlog::logger> Log::s_Logger;
 
-void Log::Init()
+std::array<std::shared_ptr<spdlog::logger>, (size_t)LogCategory::Count> Log::s_Loggers;
+std::shared_ptr<spdlog::details::thread_pool> Log::s_ThreadPool;
+std::atomic<uint64_t> Log::s_Enqueued { 0 };
+std::atomic<uint32_t> Log::s_PeakDepth { 0 };
+
+static constexpr const char* s_CategoryNames[] = { "LINES", "SHADER", "GL", "INPUT", "PROFILER" };
+static_assert(std::size(s_CategoryNames) == (size_t)LogCategory::Count, "Every log category needs a name");
+
+// Flush() posts a marker through this logger and waits for the worker to reach it. There is
+// one worker, so by then every message queued before the marker has been written.
+static std::shared_ptr<spdlog::logger> s_FlushMarker;
+static std::mutex s_FlushPostMutex;
+static std::mutex s_FlushMutex;
+static std::condition_variable s_FlushDone;
+static uint64_t s_FlushesPosted = 0;
+static uint64_t s_FlushesDone = 0;
+
+void Log::Init(const LogSettings& settings)
+{
+	if (s_Loggers[0]) return;
+
+	auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+	sink->set_pattern("%^[%T] %n: %v%$");
+
+	// One worker keeps messages in order across categories.
+	spdlog::async_overflow_policy policy = spdlog::async_overflow_policy::block;
+	if (settings.async)
+	{
+		s_ThreadPool = std::make_shared<spdlog::details::thread_pool>(settings.queueSize, 1);
+		if (settings.overflow == LogOverflow::DropOldest) policy = spdlog::async_overflow_policy::overrun_oldest;
+		else if (settings.overflow == LogOverflow::DropNewest) policy = spdlog::async_overflow_policy::discard_new;
+	}
+
+	for (size_t i = 0; i < s_Loggers.size(); i++)
+	{
+		if (s_ThreadPool)
+			s_Loggers[i] = std::make_shared<spdlog::async_logger>(s_CategoryNames[i], sink, s_ThreadPool, policy);
+		else
+			s_Loggers[i] = std::make_shared<spdlog::logger>(s_CategoryNames[i], sink);
+		s_Loggers[i]->set_level(spdlog::level::trace);
+		spdlog::register_logger(s_Loggers[i]);
+	}
+
+	if (s_ThreadPool)
+	{
+		auto marker = std::make_shared<spdlog::sinks::callback_sink_mt>([sink](const spdlog::details::log_msg&)
+		{
+			sink->flush();
+			std::lock_guard<std::mutex> lock(s_FlushMutex);
+			s_FlushesDone++;
+			s_FlushDone.notify_all();
+		});
+		// Blocks rather than drops when the queue is full: a lost marker would never be reached.
+		s_FlushMarker = std::make_shared<spdlog::async_logger>("FLUSH", marker, s_ThreadPool, spdlog::async_overflow_policy::block);
+		s_FlushMarker->set_level(spdlog::level::trace);
+	}
+}
+
+void Log::Flush()
+{
+	if (!s_FlushMarker)
+	{
+		for (auto& logger : s_Loggers)
+		{
+			if (logger) logger->flush();
+		}
+		return;
+	}
+
+	// Markers are reached in the order they are posted, so the n-th one posted is done once n are.
+	uint64_t ticket;
+	{
+		std::lock_guard<std::mutex> lock(s_FlushPostMutex);
+		ticket = ++s_FlushesPosted;
+		s_FlushMarker->info("");
+	}
+
+	std::unique_lock<std::mutex> lock(s_FlushMutex);
+	s_FlushDone.wait(lock, [ticket] { return s_FlushesDone >= ticket; });
+}
+
+void Log::SetLevel(LogCategory category, spdlog::level::level_enum level)
+{
+	GetLogger(category)->set_level(level);
+}
+
+bool Log::Configure(const char* spec)
+{
+	bool valid = true;
+	std::string entries = spec;
+	size_t start = 0;
+	while (start <= entries.size())
+	{
+		size_t end = entries.find(',', start);
+		if (end == std::string::npos) end = entries.size();
+		std::string entry = entries.substr(start, end - start);
+		start = end + 1;
+		if (entry.empty()) continue;
+
+		size_t equals = entry.find('=');
+		std::string name = entry.substr(0, equals);
+		for (char& c : name) c = (char)std::toupper((unsigned char)c);
+
+		spdlog::level::level_enum level = spdlog::level::from_str(equals == std::string::npos ? "" : entry.substr(equals + 1));
+		if (equals == std::string::npos || (level == spdlog::level::off && entry.substr(equals + 1) != "off"))
+		{
+			LOG_ERROR("Unknown log level in '{}'", entry);
+			valid = false;
+			continue;
+		}
+
+		bool found = false;
+		for (size_t i = 0; i < s_Loggers.size(); i++)
+		{
+			if (name == "ALL" || name == s_CategoryNames[i])
+			{
+				SetLevel((LogCategory)i, level);
+				found = true;
+			}
+		}
+		if (!found)
+		{
+			LOG_ERROR("Unknown log category '{}'", entry.substr(0, equals));
+			valid = false;
+		}
+	}
+	return valid;
+}
+
+bool Log::ParseOverflow(const char* name, LogOverflow& overflow)
+{
+	if (std::strcmp(name, "block") == 0) overflow = LogOverflow::Block;
+	else if (std::strcmp(name, "drop-oldest") == 0) overflow = LogOverflow::DropOldest;
+	else if (std::strcmp(name, "drop-newest") == 0) overflow = LogOverflow::DropNewest;
+	else return false;
+	return true;
+}
+
+LogMetrics Log::GetMetrics()
+{
+	LogMetrics metrics = { s_ThreadPool != nullptr, s_Enqueued.load(std::memory_order_relaxed), 0, 0, 0 };
+	if (s_ThreadPool)
+	{
+		metrics.dropped = s_ThreadPool->overrun_counter() + s_ThreadPool->discard_counter();
+		metrics.queueDepth = (uint32_t)s_ThreadPool->queue_size();
+		metrics.peakQueueDepth = s_PeakDepth.load(std::memory_order_relaxed);
+	}
+	return metrics;
+}
+
+void Log::notePeakDepth()
 {
-	spdlog::set_pattern("%^[%T] %n: %v%$");
-	s_Logger = spdlog::stdout_color_mt("LINES");
-	s_Logger->set_level(spdlog::level::trace);
-}
\ No newline at end of file
+	uint32_t depth = (uint32_t)s_ThreadPool->queue_size();
+	uint32_t peak = s_PeakDepth.load(std::memory_order_relaxed);
+	while (depth > peak && !s_PeakDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed))
+	{
+	}
+}
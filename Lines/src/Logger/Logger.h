@@ -1,22 +1,143 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <memory>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+// Levels for LOG_ACTIVE_LEVEL, matching spdlog::level::level_enum.
+#define LOG_LEVEL_TRACE    0
+#define LOG_LEVEL_INFO     2
+#define LOG_LEVEL_WARN     3
+#define LOG_LEVEL_ERROR    4
+#define LOG_LEVEL_CRITICAL 5
+#define LOG_LEVEL_OFF      6
+
+// Calls below this level are removed by the preprocessor, arguments included. Debug builds
+// keep everything; other builds keep warnings and up unless the build defines its own.
+#ifndef LOG_ACTIVE_LEVEL
+	#ifdef LINES_DEBUG
+		#define LOG_ACTIVE_LEVEL LOG_LEVEL_TRACE
+	#else
+		#define LOG_ACTIVE_LEVEL LOG_LEVEL_WARN
+	#endif
+#endif
+
+// Each category is its own spdlog logger sharing one console sink, so its verbosity can be
+// changed at runtime without touching the others.
+enum class LogCategory : uint8_t
+{
+	General, Shader, GL, Input, Profiler,
+	Count
+};
+
+namespace spdlog::details { class thread_pool; }
+
+enum class LogOverflow : uint8_t
+{
+	Block,		// the logging thread waits for room, nothing is lost
+	DropOldest,	// the oldest queued message is overwritten
+	DropNewest	// the message being logged is discarded
+};
+
+struct LogSettings
+{
+	// Formats on the calling thread but leaves the console writes to a background thread.
+	bool async { false };
+	uint32_t queueSize { 8192 };
+	LogOverflow overflow { LogOverflow::DropOldest };
+};
+
+struct LogMetrics
+{
+	bool async;
+	uint64_t enqueued;	// messages that passed the level checks
+	uint64_t dropped;	// lost to a full queue
+	uint32_t queueDepth;
+	uint32_t peakQueueDepth;
+};
+
 class Log
 {
 public:
-	static void Init();
+	// Must run before anything logs to take effect; a logger created on first use is synchronous.
+	static void Init(const LogSettings& settings = {});
+	// Waits until every message logged before the call, bar any the overflow policy dropped, has
+	// been written and the console flushed. Call before exiting or breaking into the debugger.
+	static void Flush();
+
+	// Initializes on first use too, with the default settings, for code that logs before Init().
+	static std::shared_ptr<spdlog::logger>& GetLogger(LogCategory category = LogCategory::General)
+	{
+		if (!s_Loggers[0]) Init();
+		return s_Loggers[(size_t)category];
+	}
+
+	static void SetLevel(LogCategory category, spdlog::level::level_enum level);
+	// Applies a comma-separated list such as "shader=trace,gl=warn". Categories go by the
+	// names they print under (lines, shader, gl, input, profiler) and "all" names every one.
+	// Returns false, leaving the rest applied, if an entry is not understood.
+	static bool Configure(const char* spec);
+	// Accepts "block", "drop-oldest" or "drop-newest".
+	static bool ParseOverflow(const char* name, LogOverflow& overflow);
 
-	static std::shared_ptr<spdlog::logger>& GetLogger() { return s_Logger; }
+	static LogMetrics GetMetrics();
+
+	template<typename... Args>
+	static void Write(LogCategory category, spdlog::level::level_enum level, spdlog::format_string_t<Args...> format, Args&&... args)
+	{
+		spdlog::logger& logger = *GetLogger(category);
+		if (!logger.should_log(level)) return;
+
+		logger.log(level, format, std::forward<Args>(args)...);
+		s_Enqueued.fetch_add(1, std::memory_order_relaxed);
+		if (s_ThreadPool) notePeakDepth();
+	}
+private:
+	static void notePeakDepth();
 private:
-	static std::shared_ptr<spdlog::logger> s_Logger;
+	static std::array<std::shared_ptr<spdlog::logger>, (size_t)LogCategory::Count> s_Loggers;
+	static std::shared_ptr<spdlog::details::thread_pool> s_ThreadPool;
+	static std::atomic<uint64_t> s_Enqueued;
+	static std::atomic<uint32_t> s_PeakDepth;
 };
 
 
-#define LOG_TRACE(...)    Log::GetLogger()->trace(__VA_ARGS__)
-#define LOG_INFO(...)     Log::GetLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...)     Log::GetLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...)    Log::GetLogger()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) Log::GetLogger()->critical(__VA_ARGS__)
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_TRACE
+	#define LOG_TRACE_TO(category, ...)    Log::Write(LogCategory::category, spdlog::level::trace, __VA_ARGS__)
+#else
+	#define LOG_TRACE_TO(category, ...)    ((void)0)
+#endif
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_INFO
+	#define LOG_INFO_TO(category, ...)     Log::Write(LogCategory::category, spdlog::level::info, __VA_ARGS__)
+#else
+	#define LOG_INFO_TO(category, ...)     ((void)0)
+#endif
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_WARN
+	#define LOG_WARN_TO(category, ...)     Log::Write(LogCategory::category, spdlog::level::warn, __VA_ARGS__)
+#else
+	#define LOG_WARN_TO(category, ...)     ((void)0)
+#endif
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_ERROR
+	#define LOG_ERROR_TO(category, ...)    Log::Write(LogCategory::category, spdlog::level::err, __VA_ARGS__)
+#else
+	#define LOG_ERROR_TO(category, ...)    ((void)0)
+#endif
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_CRITICAL
+	#define LOG_CRITICAL_TO(category, ...) Log::Write(LogCategory::category, spdlog::level::critical, __VA_ARGS__)
+#else
+	#define LOG_CRITICAL_TO(category, ...) ((void)0)
+#endif
+
+#define LOG_TRACE(...)    LOG_TRACE_TO(General, __VA_ARGS__)
+#define LOG_INFO(...)     LOG_INFO_TO(General, __VA_ARGS__)
+#define LOG_WARN(...)     LOG_WARN_TO(General, __VA_ARGS__)
+#define LOG_ERROR(...)    LOG_ERROR_TO(General, __VA_ARGS__)
+#define LOG_CRITICAL(...) LOG_CRITICAL_TO(General, __VA_ARGS__)
+
+#if defined(_MSC_VER)
+	#define DEBUG_BREAK() __debugbreak()
+#else
+	#define DEBUG_BREAK() __builtin_trap()
+#endif
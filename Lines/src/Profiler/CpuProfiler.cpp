@@ -0,0 +1,233 @@
+#include "CpuProfiler.h"
+#include <imgui/imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "TraceLog.h"
+#include "../Logger/Logger.h"
+
+
+uint64_t CpuProfiler::s_FrameStart = 0;
+uint64_t CpuProfiler::s_LastFrameStart = 0;
+uint64_t CpuProfiler::s_LastFrameEnd = 0;
+std::vector<CpuEvent> CpuProfiler::s_LastFrame;
+bool CpuProfiler::s_Paused = false;
+std::mutex CpuProfiler::s_RegistryMutex;
+std::vector<std::unique_ptr<CpuProfiler::ThreadBuffer>> CpuProfiler::s_Registry;
+std::atomic<bool> CpuProfiler::s_Saving { false };
+
+CpuProfiler::Zone::Zone(const char* name)
+	: m_Name { name }, m_Start { Now() }
+{
+	GetThreadBuffer().depth++;
+}
+
+CpuProfiler::Zone::~Zone()
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	buffer.depth--;
+
+	// Pairs with SaveTrace: either the save sees this write in progress and waits for it, or
+	// this sees the save and drops the event. Both need the sequentially consistent order.
+	buffer.writing.store(true);
+	if (s_Saving.load())
+	{
+		buffer.writing.store(false, std::memory_order_release);
+		return;
+	}
+
+	// Only this thread writes the buffer; the release store publishes the event to readers.
+	uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	buffer.events[head % BufferSize] = { m_Name, m_Start, Now(), buffer.depth };
+	buffer.head.store(head + 1, std::memory_order_release);
+	buffer.writing.store(false, std::memory_order_release);
+}
+
+void CpuProfiler::SetThreadName(const char* name)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	{
+		// SaveTrace reads the names of every thread under the same lock.
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		buffer.name = name;
+	}
+	TraceLog::SetThreadName(name);
+}
+
+void CpuProfiler::BeginFrame()
+{
+	uint64_t now = Now();
+	if (!s_Paused && s_FrameStart != 0)
+	{
+		// Walk back from the newest event until the previous frame boundary. The last iteration's
+		// Frame zone has closed by now and is included; zones still open here, such as one
+		// around the whole loop, are not written yet and are left out.
+		ThreadBuffer& buffer = GetThreadBuffer();
+		uint64_t head = buffer.head.load(std::memory_order_acquire);
+		uint64_t oldest = head > BufferSize ? head - BufferSize : 0;
+
+		s_LastFrame.clear();
+		for (uint64_t i = head; i > oldest; i--)
+		{
+			const CpuEvent& event = buffer.events[(i - 1) % BufferSize];
+			if (event.end < s_FrameStart)
+				break;
+			if (event.start >= s_FrameStart)
+				s_LastFrame.push_back(event);
+		}
+		std::reverse(s_LastFrame.begin(), s_LastFrame.end());
+
+		s_LastFrameStart = s_FrameStart;
+		s_LastFrameEnd = now;
+	}
+	s_FrameStart = now;
+}
+
+void CpuProfiler::DrawPanel()
+{
+	ImGui::Begin("CPU Profiler");
+
+	float frameMs = (s_LastFrameEnd - s_LastFrameStart) * 1e-6f;
+	ImGui::Text("Frame %.3f ms, %u zones", frameMs, (uint32_t)s_LastFrame.size());
+	ImGui::Checkbox("Pause", &s_Paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Save Trace"))
+	{
+		SaveTrace("cache/trace.json");
+	}
+
+	// Flame graph of the last finished frame: x is time, rows are nesting depth.
+	constexpr float rowHeight = 22.f;
+	uint32_t maxDepth = 0;
+	for (const CpuEvent& event : s_LastFrame)
+		maxDepth = std::max(maxDepth, event.depth);
+
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = std::max(ImGui::GetContentRegionAvail().x, 100.f);
+	float height = rowHeight * (maxDepth + 1);
+	ImGui::InvisibleButton("##flamegraph", ImVec2(width, height));
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	double scale = s_LastFrameEnd > s_LastFrameStart ? width / (double)(s_LastFrameEnd - s_LastFrameStart) : 0.0;
+	ImVec2 mouse = ImGui::GetIO().MousePos;
+	for (const CpuEvent& event : s_LastFrame)
+	{
+		ImVec2 min = { origin.x + (float)((event.start - s_LastFrameStart) * scale), origin.y + rowHeight * event.depth };
+		ImVec2 max = { origin.x + (float)((event.end - s_LastFrameStart) * scale), min.y + rowHeight - 1.f };
+		max.x = std::max(max.x, min.x + 1.f);
+
+		// Colour by name so the same zone keeps its colour from frame to frame.
+		uint32_t hash = (uint32_t)(std::hash<const void*>()(event.name) * 2654435761u);
+		ImU32 color = IM_COL32(120 + hash % 100, 100 + (hash >> 8) % 80, 60 + (hash >> 16) % 60, 255);
+		drawList->AddRectFilled(min, max, color);
+
+		const char* name = event.name;
+		if (ImGui::CalcTextSize(name).x < max.x - min.x - 4.f)
+			drawList->AddText(ImVec2(min.x + 2.f, min.y + 1.f), IM_COL32_BLACK, name);
+
+		if (ImGui::IsItemHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+			ImGui::SetTooltip("%s\n%.3f ms", name, (event.end - event.start) * 1e-6f);
+	}
+
+	ImGui::End();
+}
+
+bool CpuProfiler::SaveTrace(const std::string& path)
+{
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+	std::ofstream stream(path);
+	if (!stream)
+	{
+		LOG_ERROR_TO(Profiler, "Cannot write trace {}", path);
+		return false;
+	}
+
+	auto writeString = [&stream](const char* text)
+	{
+		stream << '"';
+		for (; *text; text++)
+		{
+			if (*text == '"' || *text == '\\') stream << '\\';
+			stream << *text;
+		}
+		stream << '"';
+	};
+
+	// Copy the rings with every writer stopped, then format without holding anyone up.
+	struct ThreadEvents
+	{
+		uint32_t id;
+		const char* name;
+		std::vector<CpuEvent> events;
+	};
+	std::vector<ThreadEvents> threads;
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		s_Saving.store(true);
+		for (const auto& buffer : s_Registry)
+		{
+			while (buffer->writing.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			uint64_t head = buffer->head.load(std::memory_order_acquire);
+			uint64_t oldest = head > BufferSize ? head - BufferSize : 0;
+			ThreadEvents& thread = threads.emplace_back(ThreadEvents { buffer->id, buffer->name, {} });
+			thread.events.reserve(head - oldest);
+			for (uint64_t i = oldest; i < head; i++)
+				thread.events.push_back(buffer->events[i % BufferSize]);
+		}
+		s_Saving.store(false, std::memory_order_release);
+	}
+
+	stream << "{\"traceEvents\":[\n";
+	bool first = true;
+	uint32_t count = 0;
+	for (const ThreadEvents& thread : threads)
+	{
+		stream << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << thread.id << ",\"args\":{\"name\":";
+		writeString(thread.name);
+		stream << "}}";
+		first = false;
+
+		for (const CpuEvent& event : thread.events)
+		{
+			stream << ",\n{\"ph\":\"X\",\"name\":";
+			writeString(event.name);
+			stream << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0
+				<< ",\"pid\":0,\"tid\":" << thread.id << "}";
+			count++;
+		}
+	}
+	stream << "\n]}\n";
+
+	LOG_INFO_TO(Profiler, "Saved {} CPU zones to {}", count, path);
+	return true;
+}
+
+uint64_t CpuProfiler::Now()
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+CpuProfiler::ThreadBuffer& CpuProfiler::GetThreadBuffer()
+{
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer)
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		s_Registry.push_back(std::make_unique<ThreadBuffer>());
+		buffer = s_Registry.back().get();
+		buffer->head = 0;
+		buffer->writing = false;
+		buffer->depth = 0;
+		buffer->id = (uint32_t)s_Registry.size();
+		buffer->name = "Thread";
+	}
+	return *buffer;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) CpuProfiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+struct CpuEvent
+{
+	const char* name;
+	uint64_t start, end;
+	uint32_t depth;
+};
+
+// Hierarchical CPU zones. Each thread appends to its own ring of events, so recording takes
+// no lock; readers only look at events below the ring's published head. Zone names must be
+// string literals or otherwise outlive the program. Zones that close while another thread
+// saves a trace are dropped rather than written under the reader.
+class CpuProfiler
+{
+public:
+	static constexpr uint32_t BufferSize = 1 << 16;
+
+	class Zone
+	{
+	public:
+		Zone(const char* name);
+		~Zone();
+	private:
+		const char* m_Name;
+		uint64_t m_Start;
+	};
+
+	// Names the calling thread in the trace, and in the TraceLog event trace.
+	static void SetThreadName(const char* name);
+
+	// Called by the main thread between frames; keeps the finished frame for the flame graph.
+	static void BeginFrame();
+
+	static void DrawPanel();
+
+	// Writes every buffered event as chrome://tracing / Perfetto JSON.
+	static bool SaveTrace(const std::string& path);
+
+	static uint64_t Now();
+private:
+	struct ThreadBuffer
+	{
+		CpuEvent events[BufferSize];
+		std::atomic<uint64_t> head;
+		std::atomic<bool> writing;	// set while the owning thread fills a slot
+		uint32_t depth;
+		uint32_t id;
+		const char* name;
+	};
+
+	static ThreadBuffer& GetThreadBuffer();
+private:
+	// Buffers are registered once per thread and never freed, so a trace can still be saved
+	// after a worker thread has exited.
+	static std::mutex s_RegistryMutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_Registry;
+	static std::atomic<bool> s_Saving;
+
+	static uint64_t s_FrameStart;
+	static uint64_t s_LastFrameStart, s_LastFrameEnd;
+	static std::vector<CpuEvent> s_LastFrame;
+	static bool s_Paused;
+};
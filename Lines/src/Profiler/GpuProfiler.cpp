@@ -0,0 +1,177 @@
+#include "GpuProfiler.h"
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+#include "../Logger/Logger.h"
+
+
+GpuProfiler::Scope::Scope(GpuProfiler* profiler, const char* name)
+	: m_Profiler { profiler }
+{
+	if (m_Profiler) m_Profiler->begin(name);
+}
+
+GpuProfiler::Scope::~Scope()
+{
+	if (m_Profiler) m_Profiler->end();
+}
+
+GpuProfiler::GpuProfiler()
+	: m_Frames {}, m_FrameIndex {}, m_Open {}, m_Timings {}, m_HistoryOffset {}, m_Dropped {}, m_FrameCallback {}
+{
+}
+
+GpuProfiler::~GpuProfiler()
+{
+	for (Frame& frame : m_Frames)
+		glDeleteQueries((GLsizei)frame.pool.size(), frame.pool.data());
+}
+
+void GpuProfiler::beginFrame()
+{
+	// The slot about to be reused was recorded FrameLatency frames ago.
+	Frame& frame = m_Frames[m_FrameIndex % FrameLatency];
+	collect(frame);
+
+	frame.queries.clear();
+	frame.used = 0;
+	frame.index = m_FrameIndex;
+	begin("Frame");
+}
+
+void GpuProfiler::endFrame()
+{
+	end();
+	if (!m_Open.empty())
+	{
+		LOG_ERROR_TO(Profiler, "GPU profiler scope '{}' was never closed", m_Frames[m_FrameIndex % FrameLatency].queries[m_Open.back()].name);
+		while (!m_Open.empty())
+			end();
+	}
+	m_FrameIndex++;
+}
+
+void GpuProfiler::finish()
+{
+	glFinish();
+
+	// Oldest first, so results arrive in frame order.
+	for (uint32_t i = 0; i < FrameLatency; i++)
+	{
+		Frame& frame = m_Frames[(m_FrameIndex + i) % FrameLatency];
+		collect(frame);
+		frame.queries.clear();
+		frame.used = 0;
+	}
+}
+
+void GpuProfiler::begin(const char* name)
+{
+	Frame& frame = m_Frames[m_FrameIndex % FrameLatency];
+
+	Query query = { name, (uint32_t)m_Open.size(), nextQuery(frame), 0 };
+	glQueryCounter(query.begin, GL_TIMESTAMP);
+
+	m_Open.push_back((uint32_t)frame.queries.size());
+	frame.queries.push_back(query);
+}
+
+void GpuProfiler::end()
+{
+	Frame& frame = m_Frames[m_FrameIndex % FrameLatency];
+
+	Query& query = frame.queries[m_Open.back()];
+	query.end = nextQuery(frame);
+	glQueryCounter(query.end, GL_TIMESTAMP);
+
+	m_Open.pop_back();
+}
+
+void GpuProfiler::drawPanel()
+{
+	ImGui::Begin("GPU Profiler");
+	if (m_Dropped)
+		ImGui::Text("Frames dropped (results late): %u", m_Dropped);
+
+	for (const Timing& timing : m_Timings)
+	{
+		float average = 0.f;
+		for (float value : timing.history)
+			average += value;
+		average /= std::max(timing.samples, 1u);
+
+		float latest = timing.history[(m_HistoryOffset + HistorySize - 1) % HistorySize];
+
+		ImGui::PushID(timing.name);
+		ImGui::Indent(12.f * timing.depth + 1.f);
+		ImGui::Text("%-12s %.3f ms (avg %.3f)", timing.name, latest, average);
+		ImGui::PlotLines("##history", timing.history, HistorySize, m_HistoryOffset, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 32.f));
+		ImGui::Unindent(12.f * timing.depth + 1.f);
+		ImGui::PopID();
+	}
+	ImGui::End();
+}
+
+uint32_t GpuProfiler::nextQuery(Frame& frame)
+{
+	if (frame.used == frame.pool.size())
+	{
+		uint32_t query;
+		glGenQueries(1, &query);
+		frame.pool.push_back(query);
+	}
+	return frame.pool[frame.used++];
+}
+
+void GpuProfiler::collect(Frame& frame)
+{
+	if (frame.queries.empty())
+		return;
+
+	// The last query issued finishes last, so once it is ready the whole frame is.
+	GLint available = 0;
+	glGetQueryObjectiv(frame.pool[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+	{
+		m_Dropped++;
+		return;
+	}
+
+	// Every graph shares one time axis; scopes skipped this frame read zero.
+	for (Timing& timing : m_Timings)
+		timing.history[m_HistoryOffset] = 0.f;
+
+	for (const Query& query : frame.queries)
+	{
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+
+		// A scope entered twice in one frame adds up.
+		getTiming(query.name, query.depth).history[m_HistoryOffset] += (float)(end - begin) * 1e-6f;
+	}
+
+	for (Timing& timing : m_Timings)
+		timing.samples = std::min(timing.samples + 1, HistorySize);
+
+	// The first query of a frame is its outer "Frame" scope.
+	if (m_FrameCallback)
+		m_FrameCallback(frame.index, getTiming(frame.queries.front().name, 0).history[m_HistoryOffset]);
+
+	m_HistoryOffset = (m_HistoryOffset + 1) % HistorySize;
+}
+
+GpuProfiler::Timing& GpuProfiler::getTiming(const char* name, uint32_t depth)
+{
+	for (Timing& timing : m_Timings)
+	{
+		if (timing.depth == depth && std::strcmp(timing.name, name) == 0)
+			return timing;
+	}
+
+	m_Timings.push_back({ name, depth, {}, 0 });
+	return m_Timings.back();
+}
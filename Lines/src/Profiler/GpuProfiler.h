@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Times named scopes on the GPU with GL_TIMESTAMP queries. Results are read FrameLatency
+// frames later and only once they are available, so the profiler never stalls the pipeline.
+// Scopes may nest; each frame is itself an outer "Frame" scope.
+class GpuProfiler
+{
+public:
+	static constexpr uint32_t FrameLatency = 4;
+	static constexpr uint32_t HistorySize = 120;
+
+	// Closes the scope when it goes out of scope; a null profiler makes it a no-op.
+	// Names must outlive the profiler.
+	class Scope
+	{
+	public:
+		Scope(GpuProfiler* profiler, const char* name);
+		~Scope();
+	private:
+		GpuProfiler* m_Profiler;
+	};
+
+	GpuProfiler();
+	~GpuProfiler();
+
+	void beginFrame();
+	void endFrame();
+
+	// Blocks until every frame still in flight is collected; for the end of a benchmark run.
+	void finish();
+
+	// Called with each frame's total GPU time once its results have been read.
+	inline void setFrameCallback(std::function<void(uint32_t frame, float milliseconds)> callback) { m_FrameCallback = std::move(callback); }
+
+	void begin(const char* name);
+	void end();
+
+	// Per-scope GPU milliseconds with a history graph, indented by nesting depth.
+	void drawPanel();
+private:
+	struct Query
+	{
+		const char* name;
+		uint32_t depth;
+		uint32_t begin, end;
+	};
+
+	struct Frame
+	{
+		std::vector<uint32_t> pool;
+		std::vector<Query> queries;
+		uint32_t used;
+		uint32_t index;
+	};
+
+	struct Timing
+	{
+		const char* name;
+		uint32_t depth;
+		float history[HistorySize];
+		uint32_t samples;	// frames collected since the scope first appeared, up to HistorySize
+	};
+
+	uint32_t nextQuery(Frame& frame);
+	void collect(Frame& frame);
+	Timing& getTiming(const char* name, uint32_t depth);
+private:
+	Frame m_Frames[FrameLatency];
+	uint32_t m_FrameIndex;
+	std::vector<uint32_t> m_Open;
+	std::vector<Timing> m_Timings;
+	uint32_t m_HistoryOffset;
+	uint32_t m_Dropped;
+	std::function<void(uint32_t, float)> m_FrameCallback;
+};
@@ -0,0 +1,136 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+
+#include "../Logger/Logger.h"
+
+
+Percentiles Percentiles::Compute(std::vector<double>& samples)
+{
+	Percentiles result = {};
+	if (samples.empty())
+		return result;
+
+	std::sort(samples.begin(), samples.end());
+	auto rank = [&samples](double percentile)
+	{
+		size_t index = (size_t)std::ceil(percentile / 100.0 * samples.size());
+		return samples[std::clamp<size_t>(index, 1, samples.size()) - 1];
+	};
+
+	result.count = (uint32_t)samples.size();
+	result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+	result.p50 = rank(50.0);
+	result.p90 = rank(90.0);
+	result.p95 = rank(95.0);
+	result.p99 = rank(99.0);
+	result.max = samples.back();
+	return result;
+}
+
+Telemetry::Telemetry(uint32_t frameCount)
+	: m_Samples {}, m_FrameCount { frameCount }
+{
+	m_Samples.reserve(frameCount);
+}
+
+void Telemetry::record(const FrameSample& sample)
+{
+	if (!isComplete())
+		m_Samples.push_back(sample);
+}
+
+void Telemetry::setGpuTime(uint32_t frame, float milliseconds)
+{
+	if (frame < m_Samples.size())
+		m_Samples[frame].gpuMs = milliseconds;
+}
+
+bool Telemetry::writeCsv(const std::string& path) const
+{
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (!file)
+	{
+		LOG_ERROR_TO(Profiler, "Cannot write telemetry {}", path);
+		return false;
+	}
+
+	std::fprintf(file, "frame,cpu_ms,gpu_ms,swap_ms,draw_calls,bytes_uploaded\n");
+	for (const FrameSample& sample : m_Samples)
+	{
+		std::fprintf(file, "%u,%.4f,%.4f,%.4f,%u,%" PRIu64 "\n", sample.frame, sample.cpuMs, sample.gpuMs,
+			sample.swapMs, sample.drawCalls, sample.bytesUploaded);
+	}
+	std::fclose(file);
+
+	LOG_INFO_TO(Profiler, "Saved {} frames of telemetry to {}", m_Samples.size(), path);
+	return true;
+}
+
+bool Telemetry::ReadCsv(const std::string& path, std::vector<FrameSample>& samples)
+{
+	FILE* file = std::fopen(path.c_str(), "r");
+	if (!file)
+	{
+		LOG_ERROR_TO(Profiler, "Cannot read telemetry {}", path);
+		return false;
+	}
+
+	char header[256];
+	if (!std::fgets(header, sizeof(header), file))
+	{
+		std::fclose(file);
+		return false;
+	}
+
+	FrameSample sample = {};
+	while (std::fscanf(file, "%u,%f,%f,%f,%u,%" SCNu64, &sample.frame, &sample.cpuMs, &sample.gpuMs,
+		&sample.swapMs, &sample.drawCalls, &sample.bytesUploaded) == 6)
+	{
+		samples.push_back(sample);
+	}
+	std::fclose(file);
+	return true;
+}
+
+Percentiles Telemetry::Summarize(const std::vector<FrameSample>& samples, float FrameSample::* field)
+{
+	std::vector<double> values;
+	values.reserve(samples.size());
+	for (const FrameSample& sample : samples)
+	{
+		// Frames whose GPU result never arrived are left out rather than counted as zero.
+		if (sample.*field >= 0.f)
+			values.push_back(sample.*field);
+	}
+	return Percentiles::Compute(values);
+}
+
+void Telemetry::PrintSummary(const std::vector<FrameSample>& samples)
+{
+	auto print = [&samples](const char* label, float FrameSample::* field)
+	{
+		Percentiles percentiles = Summarize(samples, field);
+		std::printf("%-6s n=%-6u p50 %8.3f  p95 %8.3f  p99 %8.3f ms\n", label, percentiles.count, percentiles.p50, percentiles.p95, percentiles.p99);
+	};
+
+	print("cpu", &FrameSample::cpuMs);
+	print("gpu", &FrameSample::gpuMs);
+	print("swap", &FrameSample::swapMs);
+
+	double drawCalls = 0.0, bytes = 0.0;
+	for (const FrameSample& sample : samples)
+	{
+		drawCalls += sample.drawCalls;
+		bytes += (double)sample.bytesUploaded;
+	}
+	size_t count = std::max<size_t>(samples.size(), 1);
+	std::printf("%.1f draw calls and %.1f KiB uploaded per frame\n", drawCalls / count, bytes / count / 1024.0);
+}
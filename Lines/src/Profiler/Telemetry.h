@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Percentiles
+{
+	uint32_t count;
+	double mean, p50, p90, p95, p99, max;
+
+	// Nearest-rank percentiles; the samples are sorted in place.
+	static Percentiles Compute(std::vector<double>& samples);
+};
+
+struct FrameSample
+{
+	uint32_t frame;
+	float cpuMs;	// frame start until the swap is issued
+	float gpuMs;	// GpuProfiler's "Frame" scope, negative until its result arrives
+	float swapMs;
+	uint32_t drawCalls;
+	uint64_t bytesUploaded;
+};
+
+// Per-frame timings and counters of a benchmark run, saved as CSV so runs can be compared
+// after the window has closed ("Benchmark compare base.csv new.csv").
+class Telemetry
+{
+public:
+	Telemetry(uint32_t frameCount);
+
+	void record(const FrameSample& sample);
+	// GPU times arrive GpuProfiler::FrameLatency frames after the sample was recorded.
+	void setGpuTime(uint32_t frame, float milliseconds);
+
+	inline bool isComplete() const { return m_Samples.size() >= m_FrameCount; }
+	inline uint32_t getFrameCount() const { return m_FrameCount; }
+	inline const std::vector<FrameSample>& getSamples() const { return m_Samples; }
+
+	bool writeCsv(const std::string& path) const;
+
+	static bool ReadCsv(const std::string& path, std::vector<FrameSample>& samples);
+	// p50/p95/p99 of each timing plus per-frame averages of the counters.
+	static void PrintSummary(const std::vector<FrameSample>& samples);
+	static Percentiles Summarize(const std::vector<FrameSample>& samples, float FrameSample::* field);
+private:
+	std::vector<FrameSample> m_Samples;
+	uint32_t m_FrameCount;
+};
@@ -0,0 +1,175 @@
+#include "TraceLog.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "../Logger/Logger.h"
+
+
+std::atomic<bool> TraceLog::s_Enabled { true };
+std::atomic<bool> TraceLog::s_Saving { false };
+std::mutex TraceLog::s_RegistryMutex;
+std::vector<TraceFormat> TraceLog::s_Formats;
+std::vector<std::unique_ptr<TraceLog::ThreadBuffer>> TraceLog::s_Buffers;
+
+static constexpr uint32_t TraceMagic = 0x4354524c; // "LRTC"
+static constexpr uint32_t TraceVersion = 1;
+
+void TraceLog::SetThreadName(const char* name)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(s_RegistryMutex);
+	buffer.name = name;
+}
+
+bool TraceLog::Save(const std::string& path)
+{
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+	std::ofstream stream(path, std::ios::binary);
+	if (!stream)
+	{
+		LOG_ERROR_TO(Profiler, "Cannot write trace {}", path);
+		return false;
+	}
+
+	auto write = [&stream](const void* data, size_t size) { stream.write((const char*)data, size); };
+	auto writeU32 = [&write](uint32_t value) { write(&value, sizeof(value)); };
+	auto writeString = [&](const std::string& text)
+	{
+		writeU32((uint32_t)text.size());
+		write(text.data(), text.size());
+	};
+
+	std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+	// Copy the rings with every writer stopped (see Write), then write the file at leisure.
+	std::vector<TraceThread> threads;
+	s_Saving.store(true);
+	for (const auto& buffer : s_Buffers)
+	{
+		while (buffer->writing.load(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		uint64_t head = buffer->head.load(std::memory_order_acquire);
+		uint64_t oldest = head > BufferSize ? head - BufferSize : 0;
+		TraceThread& thread = threads.emplace_back(TraceThread { buffer->id, buffer->name, {} });
+		thread.records.reserve(head - oldest);
+		for (uint64_t i = oldest; i < head; i++)
+			thread.records.push_back(buffer->records[i % BufferSize]);
+	}
+	s_Saving.store(false, std::memory_order_release);
+
+	writeU32(TraceMagic);
+	writeU32(TraceVersion);
+
+	writeU32((uint32_t)s_Formats.size());
+	for (const TraceFormat& format : s_Formats)
+	{
+		writeString(format.text);
+		writeU32((uint32_t)format.args.size());
+		write(format.args.data(), format.args.size());
+	}
+
+	uint64_t total = 0;
+	writeU32((uint32_t)threads.size());
+	for (const TraceThread& thread : threads)
+	{
+		uint64_t count = thread.records.size();
+		writeU32(thread.id);
+		writeString(thread.name);
+		write(&count, sizeof(count));
+		write(thread.records.data(), count * sizeof(TraceRecord));
+		total += count;
+	}
+
+	if (!stream)
+	{
+		LOG_ERROR_TO(Profiler, "Failed while writing trace {}", path);
+		return false;
+	}
+	LOG_INFO_TO(Profiler, "Saved {} trace events to {}", total, path);
+	return true;
+}
+
+bool TraceLog::Read(const std::string& path, TraceFile& file)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream)
+	{
+		LOG_ERROR_TO(Profiler, "Cannot read trace {}", path);
+		return false;
+	}
+
+	auto read = [&stream](void* data, size_t size) { return (bool)stream.read((char*)data, size); };
+	auto readU32 = [&read](uint32_t& value) { return read(&value, sizeof(value)); };
+	auto readString = [&](std::string& text)
+	{
+		uint32_t length = 0;
+		if (!readU32(length)) return false;
+		text.resize(length);
+		return read(text.data(), length);
+	};
+
+	uint32_t magic = 0, version = 0;
+	if (!readU32(magic) || !readU32(version) || magic != TraceMagic || version != TraceVersion)
+	{
+		LOG_ERROR_TO(Profiler, "{} is not a version {} trace", path, TraceVersion);
+		return false;
+	}
+
+	file = {};
+	uint32_t formatCount = 0;
+	bool valid = readU32(formatCount);
+	for (uint32_t i = 0; valid && i < formatCount; i++)
+	{
+		TraceFormat& format = file.formats.emplace_back();
+		uint32_t argCount = 0;
+		valid = readString(format.text) && readU32(argCount);
+		format.args.resize(argCount);
+		valid = valid && read(format.args.data(), argCount);
+	}
+
+	uint32_t threadCount = 0;
+	valid = valid && readU32(threadCount);
+	for (uint32_t i = 0; valid && i < threadCount; i++)
+	{
+		TraceThread& thread = file.threads.emplace_back();
+		uint64_t count = 0;
+		valid = readU32(thread.id) && readString(thread.name) && read(&count, sizeof(count)) && count <= BufferSize;
+		if (!valid) break;
+		thread.records.resize(count);
+		valid = read(thread.records.data(), count * sizeof(TraceRecord));
+	}
+
+	if (!valid)
+	{
+		LOG_ERROR_TO(Profiler, "Trace {} is truncated", path);
+		return false;
+	}
+	return true;
+}
+
+uint32_t TraceLog::Register(const char* text, std::vector<TraceArg> args)
+{
+	std::lock_guard<std::mutex> lock(s_RegistryMutex);
+	s_Formats.push_back({ text, std::move(args) });
+	return (uint32_t)s_Formats.size() - 1;
+}
+
+TraceLog::ThreadBuffer& TraceLog::GetThreadBuffer()
+{
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer)
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		s_Buffers.push_back(std::make_unique<ThreadBuffer>());
+		buffer = s_Buffers.back().get();
+		buffer->head = 0;
+		buffer->writing = false;
+		buffer->id = (uint32_t)s_Buffers.size();
+		buffer->name = "Thread";
+	}
+	return *buffer;
+}
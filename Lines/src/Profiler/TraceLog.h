@@ -0,0 +1,142 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "CpuProfiler.h"
+
+// Records a binary trace event. The format uses fmt syntax and must be a string literal;
+// the arguments must be numbers. Only the raw values are stored here. Formatting happens
+// offline in "Benchmark trace".
+#define TRACE_EVENT(format, ...) \
+	do \
+	{ \
+		struct TraceCallSite { static constexpr const char* Text() { return format; } }; \
+		TraceLog::Write(TraceCallSite {}, ##__VA_ARGS__); \
+	} while (0)
+
+enum class TraceArg : uint8_t
+{
+	Bool, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double
+};
+
+struct TraceRecord
+{
+	static constexpr uint32_t PayloadSize = 48;
+
+	uint64_t time;		// CpuProfiler::Now()
+	uint32_t format;	// index into the registered formats
+	uint32_t reserved;
+	uint8_t payload[PayloadSize];
+};
+
+static_assert(sizeof(TraceRecord) == 64, "TraceRecord is written to disk as is");
+
+struct TraceFormat
+{
+	std::string text;
+	std::vector<TraceArg> args;
+};
+
+struct TraceThread
+{
+	uint32_t id;
+	std::string name;
+	std::vector<TraceRecord> records;
+};
+
+struct TraceFile
+{
+	std::vector<TraceFormat> formats;
+	std::vector<TraceThread> threads;
+};
+
+// Binary event channel for data too frequent to log as text. Each call site registers its
+// format string once. After that, an event costs a timestamp and a copy of its arguments into
+// a per-thread ring of fixed-size records. No lock is taken and nothing is formatted. The
+// rings keep the latest BufferSize events per thread. Save() writes them out for decoding.
+class TraceLog
+{
+public:
+	static constexpr uint32_t BufferSize = 1 << 16;
+
+	template<typename Format, typename... Args>
+	static void Write(Format, Args... args)
+	{
+		static_assert((std::is_arithmetic_v<Args> && ...), "Trace arguments must be numbers");
+		static_assert((sizeof(Args) + ... + 0) <= TraceRecord::PayloadSize, "Trace arguments do not fit in a record");
+
+		static const uint32_t format = Register(Format::Text(), { ArgType<Args>()... });
+		if (!s_Enabled.load(std::memory_order_relaxed))
+			return;
+
+		// Same handshake as CpuProfiler::Zone: an event that lands during Save() is dropped.
+		ThreadBuffer& buffer = GetThreadBuffer();
+		buffer.writing.store(true);
+		if (s_Saving.load())
+		{
+			buffer.writing.store(false, std::memory_order_release);
+			return;
+		}
+
+		uint64_t head = buffer.head.load(std::memory_order_relaxed);
+		TraceRecord& record = buffer.records[head % BufferSize];
+		record.time = CpuProfiler::Now();
+		record.format = format;
+
+		uint8_t* data = record.payload;
+		((std::memcpy(data, &args, sizeof(Args)), data += sizeof(Args)), ...);
+		buffer.head.store(head + 1, std::memory_order_release);
+		buffer.writing.store(false, std::memory_order_release);
+	}
+
+	static void SetThreadName(const char* name);
+	inline static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+	inline static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+	// The file stores records in this machine's byte order.
+	static bool Save(const std::string& path);
+	static bool Read(const std::string& path, TraceFile& file);
+private:
+	struct ThreadBuffer
+	{
+		TraceRecord records[BufferSize];
+		std::atomic<uint64_t> head;
+		std::atomic<bool> writing;
+		uint32_t id;
+		const char* name;
+	};
+
+	template<typename T>
+	static constexpr TraceArg ArgType()
+	{
+		if constexpr (std::is_same_v<T, bool>) return TraceArg::Bool;
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point trace argument");
+			return sizeof(T) == 4 ? TraceArg::Float : TraceArg::Double;
+		}
+		else
+		{
+			// Int8, Int16, Int32 and Int64 are two apart, each followed by its unsigned twin.
+			constexpr uint8_t sizeIndex = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+			return (TraceArg)((uint8_t)TraceArg::Int8 + 2 * sizeIndex + (std::is_unsigned_v<T> ? 1 : 0));
+		}
+	}
+
+	static uint32_t Register(const char* text, std::vector<TraceArg> args);
+	static ThreadBuffer& GetThreadBuffer();
+private:
+	static std::atomic<bool> s_Enabled;
+	static std::atomic<bool> s_Saving;
+
+	// Formats and buffers are only ever added, so ids and buffers stay valid for the program's life.
+	static std::mutex s_RegistryMutex;
+	static std::vector<TraceFormat> s_Formats;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_Buffers;
+};
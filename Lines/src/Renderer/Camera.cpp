@@ -0,0 +1,143 @@
+#include "Camera.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProj)
+{
+	// Gribb and Hartmann: each plane is the last row of the matrix plus or minus one of the others.
+	glm::mat4 rows = glm::transpose(viewProj);
+
+	Frustum frustum;
+	frustum.planes[0] = rows[3] + rows[0];
+	frustum.planes[1] = rows[3] - rows[0];
+	frustum.planes[2] = rows[3] + rows[1];
+	frustum.planes[3] = rows[3] - rows[1];
+	frustum.planes[4] = rows[3] + rows[2];
+	frustum.planes[5] = rows[3] - rows[2];
+
+	for (glm::vec4& plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+	return frustum;
+}
+
+bool Frustum::intersects(const glm::vec3& min, const glm::vec3& max) const
+{
+	// The box is outside when its corner furthest along a plane's normal is still behind it.
+	for (const glm::vec4& plane : planes)
+	{
+		glm::vec3 corner = {
+			plane.x > 0.f ? max.x : min.x,
+			plane.y > 0.f ? max.y : min.y,
+			plane.z > 0.f ? max.z : min.z
+		};
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f)
+			return false;
+	}
+	return true;
+}
+
+Camera::Camera(float fovY, float nearPlane, float farPlane, const glm::vec2& viewport)
+	: m_Position { 0.f }, m_Yaw { 0.f }, m_Pitch { 0.f },
+	m_FovY { fovY }, m_Near { nearPlane }, m_Far { farPlane }, m_Viewport { viewport },
+	m_Version { 1 }, m_Dirty { ViewDirty | ProjectionDirty },
+	m_View { 1.f }, m_Projection { 1.f }, m_ViewProj { 1.f }, m_InverseViewProj { 1.f }, m_Frustum {}
+{
+}
+
+void Camera::setPosition(const glm::vec3& position)
+{
+	if (position == m_Position) return;
+	m_Position = position;
+	m_Dirty |= ViewDirty;
+	m_Version++;
+}
+
+void Camera::move(const glm::vec3& offset)
+{
+	setPosition(m_Position + offset);
+}
+
+void Camera::setRotation(float yaw, float pitch)
+{
+	if (yaw == m_Yaw && pitch == m_Pitch) return;
+	m_Yaw = yaw;
+	m_Pitch = pitch;
+	m_Dirty |= ViewDirty;
+	m_Version++;
+}
+
+void Camera::rotate(float yawOffset, float pitchOffset)
+{
+	setRotation(m_Yaw + yawOffset, m_Pitch + pitchOffset);
+}
+
+void Camera::lookAt(const glm::vec3& eye, const glm::vec3& target)
+{
+	// Inverts the rotation built in update(): yaw brings the direction into the -Z half of the
+	// YZ plane, then pitch levels it onto -Z.
+	glm::vec3 forward = glm::normalize(target - eye);
+	float horizontal = glm::length(glm::vec2(forward.x, forward.z));
+
+	setPosition(eye);
+	setRotation(std::atan2(forward.x, -forward.z), std::atan2(-forward.y, horizontal));
+}
+
+void Camera::setViewport(const glm::vec2& viewport)
+{
+	if (viewport == m_Viewport) return;
+	m_Viewport = viewport;
+	m_Dirty |= ProjectionDirty;
+	m_Version++;
+}
+
+const glm::mat4& Camera::getView() const
+{
+	update();
+	return m_View;
+}
+
+const glm::mat4& Camera::getProjection() const
+{
+	update();
+	return m_Projection;
+}
+
+const glm::mat4& Camera::getViewProj() const
+{
+	update();
+	return m_ViewProj;
+}
+
+const glm::mat4& Camera::getInverseViewProj() const
+{
+	update();
+	return m_InverseViewProj;
+}
+
+const Frustum& Camera::getFrustum() const
+{
+	update();
+	return m_Frustum;
+}
+
+void Camera::update() const
+{
+	if (!m_Dirty) return;
+
+	if (m_Dirty & ViewDirty)
+	{
+		m_View = glm::rotate(glm::mat4(1.f), m_Pitch, glm::vec3(1.f, 0.f, 0.f))
+			* glm::rotate(glm::mat4(1.f), m_Yaw, glm::vec3(0.f, 1.f, 0.f))
+			* glm::translate(glm::mat4(1.f), -m_Position);
+	}
+	if (m_Dirty & ProjectionDirty)
+	{
+		m_Projection = glm::perspective(m_FovY, m_Viewport.x / m_Viewport.y, m_Near, m_Far);
+	}
+
+	m_ViewProj = m_Projection * m_View;
+	m_InverseViewProj = glm::inverse(m_ViewProj);
+	m_Frustum = Frustum::FromMatrix(m_ViewProj);
+	m_Dirty = 0;
+}
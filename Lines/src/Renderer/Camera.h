@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Six planes facing inwards, extracted from a view-projection matrix.
+struct Frustum
+{
+	glm::vec4 planes[6];	// left, right, bottom, top, near, far
+
+	static Frustum FromMatrix(const glm::mat4& viewProj);
+
+	bool intersects(const glm::vec3& min, const glm::vec3& max) const;
+};
+
+// First-person camera: a position plus yaw around the world up axis and pitch around the
+// camera's right axis. Setters only record the change and mark what depends on it. The
+// matrices and the frustum are rebuilt the first time they are read afterwards, so a frame
+// that changes nothing does no camera math. Every change bumps the version, which caches
+// downstream (such as the FrameData upload in Scene) compare against.
+class Camera
+{
+public:
+	Camera(float fovY, float nearPlane, float farPlane, const glm::vec2& viewport);
+
+	void setPosition(const glm::vec3& position);
+	void move(const glm::vec3& offset);
+	void setRotation(float yaw, float pitch);
+	void rotate(float yawOffset, float pitchOffset);
+	// Points the camera at target. The up axis is always world Y, so there is no roll.
+	void lookAt(const glm::vec3& eye, const glm::vec3& target);
+	void setViewport(const glm::vec2& viewport);
+
+	const glm::mat4& getView() const;
+	const glm::mat4& getProjection() const;
+	const glm::mat4& getViewProj() const;
+	const glm::mat4& getInverseViewProj() const;
+	const Frustum& getFrustum() const;
+
+	inline const glm::vec3& getPosition() const { return m_Position; }
+	inline float getYaw() const { return m_Yaw; }
+	inline float getPitch() const { return m_Pitch; }
+	inline const glm::vec2& getViewport() const { return m_Viewport; }
+	inline uint64_t getVersion() const { return m_Version; }
+private:
+	void update() const;
+private:
+	enum Dirty : uint8_t
+	{
+		ViewDirty = 1 << 0,
+		ProjectionDirty = 1 << 1
+	};
+
+	glm::vec3 m_Position;
+	float m_Yaw, m_Pitch;
+	float m_FovY, m_Near, m_Far;
+	glm::vec2 m_Viewport;
+
+	uint64_t m_Version;
+
+	mutable uint8_t m_Dirty;
+	mutable glm::mat4 m_View, m_Projection, m_ViewProj, m_InverseViewProj;
+	mutable Frustum m_Frustum;
+};
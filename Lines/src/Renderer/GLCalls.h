@@ -0,0 +1,217 @@
+#pragma once
+#include <glad/glad.h>
+
+#include "GLState.h"
+#include "RenderStats.h"
+
+// Thin instrumented layer over the GL calls the renderer issues every frame. Each wrapper
+// forwards to GL and bumps the RenderStats counters; call sites use GL::DrawArrays instead
+// of glDrawArrays and so on. Writes through mapped buffers are not seen here and are
+// counted by their owners. Binds and enables are checked against GLState first and
+// dropped when they would not change anything.
+namespace GL
+{
+	// Updates the cached value, or counts the call as filtered when it is already current.
+	inline bool Changes(uint32_t& cached, uint32_t value)
+	{
+		RenderStats& stats = RenderStats::Get();
+		if (cached == value)
+		{
+			stats.filteredStateChanges++;
+			return false;
+		}
+		cached = value;
+		stats.stateChanges++;
+		return true;
+	}
+
+	inline uint32_t PrimitiveCount(GLenum mode, GLsizei count)
+	{
+		switch (mode)
+		{
+		case GL_LINES:			return count / 2;
+		case GL_LINE_STRIP:		return count > 1 ? count - 1 : 0;
+		case GL_TRIANGLES:		return count / 3;
+		case GL_TRIANGLE_STRIP:
+		case GL_TRIANGLE_FAN:	return count > 2 ? count - 2 : 0;
+		default:				return count;
+		}
+	}
+
+	inline void DrawArrays(GLenum mode, GLint first, GLsizei count)
+	{
+		glDrawArrays(mode, first, count);
+		RenderStats& stats = RenderStats::Get();
+		stats.drawCalls++;
+		stats.primitives += PrimitiveCount(mode, count);
+	}
+
+	inline void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+	{
+		glDrawArraysInstanced(mode, first, count, instances);
+		RenderStats& stats = RenderStats::Get();
+		stats.drawCalls++;
+		stats.primitives += (uint64_t)PrimitiveCount(mode, count) * instances;
+	}
+
+	inline void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+	{
+		glDrawElements(mode, count, type, indices);
+		RenderStats& stats = RenderStats::Get();
+		stats.drawCalls++;
+		stats.primitives += PrimitiveCount(mode, count);
+	}
+
+	inline void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+	{
+		glBufferData(target, size, data, usage);
+		if (data) RenderStats::Get().bytesUploaded += size;
+	}
+
+	inline void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+	{
+		glBufferSubData(target, offset, size, data);
+		RenderStats::Get().bytesUploaded += size;
+	}
+
+	inline void UseProgram(GLuint program)
+	{
+		if (Changes(GLState::Get().program, program))
+			glUseProgram(program);
+	}
+
+	inline void BindVertexArray(GLuint vertexArray)
+	{
+		GLState& state = GLState::Get();
+		if (Changes(state.vertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			state.elementBuffer = GLState::Unknown;
+		}
+	}
+
+	inline void BindBuffer(GLenum target, GLuint buffer)
+	{
+		uint32_t* cached = GLState::Get().getBuffer(target);
+		if (!cached)
+		{
+			glBindBuffer(target, buffer);
+			RenderStats::Get().stateChanges++;
+		}
+		else if (Changes(*cached, buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	// Indexed binding points are not tracked, but the call also binds the generic target.
+	inline void BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+	{
+		glBindBufferBase(target, index, buffer);
+		RenderStats::Get().stateChanges++;
+		if (uint32_t* cached = GLState::Get().getBuffer(target))
+			*cached = buffer;
+	}
+
+	// Deleting a bound object resets its binding to zero.
+	inline void DeleteBuffers(GLsizei count, const GLuint* buffers)
+	{
+		GLState& state = GLState::Get();
+		for (GLsizei i = 0; i < count; i++)
+		{
+			if (state.arrayBuffer == buffers[i]) state.arrayBuffer = 0;
+			if (state.elementBuffer == buffers[i]) state.elementBuffer = 0;
+			if (state.uniformBuffer == buffers[i]) state.uniformBuffer = 0;
+		}
+		glDeleteBuffers(count, buffers);
+	}
+
+	inline void DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays)
+	{
+		GLState& state = GLState::Get();
+		for (GLsizei i = 0; i < count; i++)
+		{
+			if (state.vertexArray == vertexArrays[i])
+			{
+				state.vertexArray = 0;
+				state.elementBuffer = GLState::Unknown;
+			}
+		}
+		glDeleteVertexArrays(count, vertexArrays);
+	}
+
+	inline void SetEnabled(GLenum capability, bool enabled)
+	{
+		GLState& state = GLState::Get();
+		uint32_t bit = GLState::CapabilityBit(capability);
+		if (bit && (state.known & bit) && ((state.enabled & bit) != 0) == enabled)
+		{
+			RenderStats::Get().filteredStateChanges++;
+			return;
+		}
+
+		if (enabled) glEnable(capability);
+		else glDisable(capability);
+		RenderStats::Get().stateChanges++;
+
+		state.known |= bit;
+		state.enabled = enabled ? state.enabled | bit : state.enabled & ~bit;
+	}
+
+	inline void Enable(GLenum capability) { SetEnabled(capability, true); }
+	inline void Disable(GLenum capability) { SetEnabled(capability, false); }
+
+	inline void BlendFunc(GLenum source, GLenum destination)
+	{
+		GLState& state = GLState::Get();
+		if (state.blendSource == source && state.blendDestination == destination)
+		{
+			RenderStats::Get().filteredStateChanges++;
+			return;
+		}
+		glBlendFunc(source, destination);
+		RenderStats::Get().stateChanges++;
+		state.blendSource = source;
+		state.blendDestination = destination;
+	}
+
+	inline void DepthFunc(GLenum func)
+	{
+		if (Changes(GLState::Get().depthFunc, func))
+			glDepthFunc(func);
+	}
+
+	inline void DepthMask(GLboolean mask)
+	{
+		if (Changes(GLState::Get().depthMask, mask))
+			glDepthMask(mask);
+	}
+
+	inline void Uniform1i(GLint location, GLint value)
+	{
+		glUniform1i(location, value);
+		RenderStats::Get().uniformUploads++;
+	}
+
+	inline void Uniform1f(GLint location, GLfloat value)
+	{
+		glUniform1f(location, value);
+		RenderStats::Get().uniformUploads++;
+	}
+
+	inline void Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+	{
+		glUniform2f(location, v0, v1);
+		RenderStats::Get().uniformUploads++;
+	}
+
+	inline void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+	{
+		glUniform3f(location, v0, v1, v2);
+		RenderStats::Get().uniformUploads++;
+	}
+
+	inline void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		glUniformMatrix4fv(location, count, transpose, value);
+		RenderStats::Get().uniformUploads++;
+	}
+}
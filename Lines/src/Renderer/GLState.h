@@ -0,0 +1,65 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+
+// Shadow copy of the context state the renderer sets, consulted by the GL:: wrappers in
+// GLCalls.h so that setting a value that is already current never reaches the driver.
+// There is one context, so there is one copy. Fields start out Unknown, which forces the
+// first call through. Code that changes state behind the wrappers' back must call
+// Invalidate() before handing control back to the renderer. ImGui's backend restores
+// everything it touches, so it does not need to.
+struct GLState
+{
+	static constexpr uint32_t Unknown = ~0u;
+
+	uint32_t program;
+	uint32_t vertexArray;
+	uint32_t arrayBuffer;
+	uint32_t elementBuffer;	// part of the bound vertex array, forgotten when it changes
+	uint32_t uniformBuffer;
+
+	uint32_t enabled;		// one bit per tracked capability, see CapabilityBit
+	uint32_t known;
+	uint32_t blendSource, blendDestination;
+	uint32_t depthFunc;
+	uint32_t depthMask;
+
+	inline static GLState& Get()
+	{
+		static GLState state = Forgotten();
+		return state;
+	}
+	inline static void Invalidate() { Get() = Forgotten(); }
+
+	// Capabilities outside this list are passed straight through.
+	inline static uint32_t CapabilityBit(GLenum capability)
+	{
+		switch (capability)
+		{
+		case GL_DEPTH_TEST:		return 1u << 0;
+		case GL_BLEND:			return 1u << 1;
+		case GL_CULL_FACE:		return 1u << 2;
+		case GL_SCISSOR_TEST:	return 1u << 3;
+		case GL_LINE_SMOOTH:	return 1u << 4;
+		case GL_MULTISAMPLE:	return 1u << 5;
+		default:				return 0;
+		}
+	}
+
+	// Binding point that caches target, or nullptr if it is not tracked.
+	inline uint32_t* getBuffer(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:			return &arrayBuffer;
+		case GL_ELEMENT_ARRAY_BUFFER:	return &elementBuffer;
+		case GL_UNIFORM_BUFFER:			return &uniformBuffer;
+		default:						return nullptr;
+		}
+	}
+private:
+	inline static GLState Forgotten()
+	{
+		return { Unknown, Unknown, Unknown, Unknown, Unknown, 0, 0, Unknown, Unknown, Unknown, Unknown };
+	}
+};
@@ -0,0 +1,67 @@
+#include "Grid.h"
+#include <glad/glad.h>
+#include <vector>
+
+#include "GLCalls.h"
+#include "LineBatch.h"
+#include "ThickLines.h"
+
+
+Grid::Grid(int32_t halfLineCount, float spacing, float height, const glm::vec3& color)
+	: m_VertexArray {}, m_VertexBuffer {}, m_SegmentArray {}, m_LineCount {}
+{
+	const float extent = halfLineCount * spacing;
+	const uint32_t linesPerAxis = 2 * halfLineCount + 1;
+	m_LineCount = 2 * linesPerAxis;
+
+	std::vector<LineVertex> vertices;
+	vertices.reserve(2 * (size_t)m_LineCount);
+
+	for (int32_t i = -halfLineCount; i <= halfLineCount; i++)
+	{
+		float offset = i * spacing;
+		// Line running along the X axis
+		vertices.push_back({ { -extent, height, offset }, color });
+		vertices.push_back({ {  extent, height, offset }, color });
+		// Line running along the Z axis
+		vertices.push_back({ { offset, height, -extent }, color });
+		vertices.push_back({ { offset, height,  extent }, color });
+	}
+
+	glGenVertexArrays(1, &m_VertexArray);
+	glGenBuffers(1, &m_VertexBuffer);
+
+	GL::BindVertexArray(m_VertexArray);
+	GL::BindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+	GL::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(LineVertex), vertices.data(), GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
+
+	glGenVertexArrays(1, &m_SegmentArray);
+	GL::BindVertexArray(m_SegmentArray);
+	ThickLines::setupSegmentAttributes(m_VertexBuffer);
+
+	GL::BindVertexArray(0);
+}
+
+Grid::~Grid()
+{
+	GL::DeleteVertexArrays(1, &m_VertexArray);
+	GL::DeleteVertexArrays(1, &m_SegmentArray);
+	GL::DeleteBuffers(1, &m_VertexBuffer);
+}
+
+void Grid::draw() const
+{
+	GL::BindVertexArray(m_VertexArray);
+	GL::DrawArrays(GL_LINES, 0, 2 * m_LineCount);
+}
+
+void Grid::drawThick() const
+{
+	GL::BindVertexArray(m_SegmentArray);
+	ThickLines::draw(m_LineCount);
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Floor grid baked once into a static vertex buffer, drawn with a single call.
+class Grid
+{
+public:
+	Grid(int32_t halfLineCount, float spacing, float height, const glm::vec3& color);
+	~Grid();
+
+	void draw() const;
+	// Draws the same segments as instanced quads; expects ThickLines::bind() beforehand.
+	void drawThick() const;
+
+	inline uint32_t getLineCount() const { return m_LineCount; }
+private:
+	uint32_t m_VertexArray, m_VertexBuffer;
+	uint32_t m_SegmentArray;
+	uint32_t m_LineCount;
+};
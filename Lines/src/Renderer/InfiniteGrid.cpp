@@ -0,0 +1,35 @@
+#include "InfiniteGrid.h"
+#include <glad/glad.h>
+
+#include "GLCalls.h"
+#include "../ShaderBatch.h"
+
+
+InfiniteGrid::InfiniteGrid(ShaderBatch& shaders, float height, const glm::vec3& color)
+	: m_Shader { nullptr }, m_VertexArray {},
+	m_Height { height }, m_MinorSpacing { 1.f }, m_MajorSpacing { 10.f },
+	m_FadeDistance { 80.f }, m_Color { color }
+{
+	m_Shader = shaders.add("res/shaders/grid.vs", "res/shaders/grid.fs");
+
+	// The quad corners come from gl_VertexID, but the core profile still needs a VAO bound to draw.
+	glGenVertexArrays(1, &m_VertexArray);
+}
+
+InfiniteGrid::~InfiniteGrid()
+{
+	GL::DeleteVertexArrays(1, &m_VertexArray);
+}
+
+void InfiniteGrid::draw()
+{
+	m_Shader->bind();
+	m_Shader->setUniform3f("u_Color", m_Color.x, m_Color.y, m_Color.z);
+	m_Shader->setUniform1f("u_Height", m_Height);
+	m_Shader->setUniform1f("u_MinorSpacing", m_MinorSpacing);
+	m_Shader->setUniform1f("u_MajorSpacing", m_MajorSpacing);
+	m_Shader->setUniform1f("u_FadeDistance", m_FadeDistance);
+
+	GL::BindVertexArray(m_VertexArray);
+	GL::DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <glm/glm.hpp>
+
+class Shader;
+class ShaderBatch;
+
+// Procedural ground-plane grid. The lines are resolved per pixel in
+// res/shaders/grid.fs, so the cost does not depend on the grid extent or zoom.
+class InfiniteGrid
+{
+public:
+	InfiniteGrid(ShaderBatch& shaders, float height, const glm::vec3& color);
+	~InfiniteGrid();
+
+	// Camera matrices come from the FrameData uniform block.
+	void draw();
+
+	inline void setSpacing(float minor, float major) { m_MinorSpacing = minor; m_MajorSpacing = major; }
+	inline void setFadeDistance(float distance) { m_FadeDistance = distance; }
+private:
+	Shader* m_Shader;
+	uint32_t m_VertexArray;
+
+	float m_Height;
+	float m_MinorSpacing, m_MajorSpacing;
+	float m_FadeDistance;
+	glm::vec3 m_Color;
+};
@@ -0,0 +1,135 @@
+#include "LineBatch.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+#include "GLCalls.h"
+
+
+LineBatch::LineBatch(uint32_t segmentsPerSection)
+	: m_VertexArray {}, m_VertexBuffer {}, m_SectionVertices { 2 * segmentsPerSection }, m_Section {},
+	m_Persistent { false }, m_Mapped { nullptr }, m_Fences {}, m_Staging {}
+{
+	const GLsizeiptr size = (GLsizeiptr)SectionCount * m_SectionVertices * sizeof(LineVertex);
+
+	glGenVertexArrays(1, &m_VertexArray);
+	glGenBuffers(1, &m_VertexBuffer);
+
+	GL::BindVertexArray(m_VertexArray);
+	GL::BindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+
+	// Persistent mapping needs GL 4.4; on a plain 3.3 context every section is mapped unsynchronized instead.
+	m_Persistent = GLAD_GL_VERSION_4_4;
+	if (m_Persistent)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+		m_Mapped = (LineVertex*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+	}
+	else
+	{
+		GL::BufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	}
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
+
+	GL::BindVertexArray(0);
+
+	m_Staging.reserve(m_SectionVertices);
+}
+
+LineBatch::~LineBatch()
+{
+	for (void* fence : m_Fences)
+	{
+		if (fence) glDeleteSync((GLsync)fence);
+	}
+
+	if (m_Mapped)
+	{
+		GL::BindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
+	GL::DeleteVertexArrays(1, &m_VertexArray);
+	GL::DeleteBuffers(1, &m_VertexBuffer);
+}
+
+void LineBatch::drawLine(const glm::vec3& a, const glm::vec3& b, const glm::vec3& color)
+{
+	m_Staging.push_back({ a, color });
+	m_Staging.push_back({ b, color });
+}
+
+void LineBatch::drawPolyline(std::span<const glm::vec3> points, const glm::vec3& color)
+{
+	if (points.size() < 2) return;
+
+	for (size_t i = 1; i < points.size(); i++)
+	{
+		m_Staging.push_back({ points[i - 1], color });
+		m_Staging.push_back({ points[i], color });
+	}
+}
+
+void LineBatch::drawSegments(std::span<const LineVertex> vertices)
+{
+	m_Staging.insert(m_Staging.end(), vertices.begin(), vertices.begin() + (vertices.size() & ~(size_t)1));
+}
+
+void LineBatch::flush()
+{
+	if (m_Staging.empty()) return;
+
+	GL::BindVertexArray(m_VertexArray);
+	GL::BindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+
+	size_t submitted = 0;
+	while (submitted < m_Staging.size())
+	{
+		uint32_t count = (uint32_t)std::min<size_t>(m_Staging.size() - submitted, m_SectionVertices);
+		size_t first = (size_t)m_Section * m_SectionVertices;
+
+		waitForSection(m_Section);
+
+		if (m_Persistent)
+		{
+			std::memcpy(m_Mapped + first, m_Staging.data() + submitted, count * sizeof(LineVertex));
+		}
+		else
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+			void* dst = glMapBufferRange(GL_ARRAY_BUFFER, first * sizeof(LineVertex), count * sizeof(LineVertex), flags);
+			std::memcpy(dst, m_Staging.data() + submitted, count * sizeof(LineVertex));
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+
+		// Both paths write through a mapping, which the GL wrappers cannot see.
+		RenderStats::Get().bytesUploaded += count * sizeof(LineVertex);
+		GL::DrawArrays(GL_LINES, (GLint)first, count);
+		m_Fences[m_Section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Section = (m_Section + 1) % SectionCount;
+		submitted += count;
+	}
+
+	m_Staging.clear();
+}
+
+void LineBatch::waitForSection(uint32_t section)
+{
+	GLsync fence = (GLsync)m_Fences[section];
+	if (!fence) return;
+
+	GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+
+	glDeleteSync(fence);
+	m_Fences[section] = nullptr;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct LineVertex
+{
+	glm::vec3 position;
+	glm::vec3 color;
+};
+
+// Immediate-mode line collector. Segments are staged on the CPU and streamed to the GPU
+// through a triple-buffered ring whose sections are guarded by fences, so a flush never
+// overwrites vertices the GPU is still reading. Uses the layout of res/shaders/shader.vs.
+class LineBatch
+{
+public:
+	LineBatch(uint32_t segmentsPerSection = 1 << 18);
+	~LineBatch();
+
+	void drawLine(const glm::vec3& a, const glm::vec3& b, const glm::vec3& color);
+	void drawPolyline(std::span<const glm::vec3> points, const glm::vec3& color);
+	// Appends ready-made segments, two vertices each.
+	void drawSegments(std::span<const LineVertex> vertices);
+
+	// Submits every staged segment with one draw call per filled ring section.
+	void flush();
+
+	inline bool isPersistent() const { return m_Persistent; }
+	inline uint32_t getSegmentsPerSection() const { return m_SectionVertices / 2; }
+private:
+	void waitForSection(uint32_t section);
+private:
+	static constexpr uint32_t SectionCount = 3;
+
+	uint32_t m_VertexArray, m_VertexBuffer;
+	uint32_t m_SectionVertices;
+	uint32_t m_Section;
+
+	bool m_Persistent;
+	LineVertex* m_Mapped;
+	void* m_Fences[SectionCount];
+
+	std::vector<LineVertex> m_Staging;
+};
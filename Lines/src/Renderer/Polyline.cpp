@@ -0,0 +1,45 @@
+#include "Polyline.h"
+#include <glad/glad.h>
+#include <vector>
+
+#include "GLCalls.h"
+#include "ThickLines.h"
+
+
+Polyline::Polyline(std::span<const LineVertex> points)
+	: m_VertexArray {}, m_VertexBuffer {}, m_PointCount { (uint32_t)points.size() }
+{
+	// The first and last points are repeated so the end segments see themselves as their
+	// neighbour, which the shader treats as an open end and caps.
+	std::vector<LineVertex> vertices;
+	vertices.reserve(points.size() + 2);
+	if (!points.empty())
+	{
+		vertices.push_back(points.front());
+		vertices.insert(vertices.end(), points.begin(), points.end());
+		vertices.push_back(points.back());
+	}
+
+	glGenVertexArrays(1, &m_VertexArray);
+	glGenBuffers(1, &m_VertexBuffer);
+
+	GL::BindVertexArray(m_VertexArray);
+	GL::BindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+	GL::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(LineVertex), vertices.data(), GL_STATIC_DRAW);
+
+	ThickLines::setupPolylineAttributes(m_VertexBuffer);
+
+	GL::BindVertexArray(0);
+}
+
+Polyline::~Polyline()
+{
+	GL::DeleteVertexArrays(1, &m_VertexArray);
+	GL::DeleteBuffers(1, &m_VertexBuffer);
+}
+
+void Polyline::draw() const
+{
+	GL::BindVertexArray(m_VertexArray);
+	ThickLines::drawPolyline(m_PointCount);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <span>
+
+#include "LineBatch.h"
+
+// Connected line strip uploaded once; drawn as one instanced call through ThickLines::bindPolyline().
+class Polyline
+{
+public:
+	Polyline(std::span<const LineVertex> points);
+	~Polyline();
+
+	void draw() const;
+
+	inline uint32_t getPointCount() const { return m_PointCount; }
+private:
+	uint32_t m_VertexArray, m_VertexBuffer;
+	uint32_t m_PointCount;
+};
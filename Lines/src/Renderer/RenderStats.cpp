@@ -0,0 +1,24 @@
+#include "RenderStats.h"
+#include <imgui/imgui.h>
+
+
+void RenderStats::DrawOverlay(const RenderStats& stats)
+{
+	// Pinned to the top-left corner of the main viewport, out of the way of the tool windows.
+	const ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 10.f, viewport->WorkPos.y + 10.f), ImGuiCond_Always);
+	ImGui::SetNextWindowViewport(viewport->ID);
+	ImGui::SetNextWindowBgAlpha(0.35f);
+
+	ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+		| ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoDocking;
+	if (ImGui::Begin("Render Stats", nullptr, flags))
+	{
+		ImGui::Text("Draw calls: %u", stats.drawCalls);
+		ImGui::Text("Primitives: %llu", (unsigned long long)stats.primitives);
+		ImGui::Text("State changes: %u (filtered %u)", stats.stateChanges, stats.filteredStateChanges);
+		ImGui::Text("Uniform uploads: %u", stats.uniformUploads);
+		ImGui::Text("Uploaded: %.1f KiB", stats.bytesUploaded / 1024.0);
+	}
+	ImGui::End();
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+// Work submitted by the renderer during the current frame, counted by the wrappers in
+// GLCalls.h. The application resets the counters when a frame begins and reads them once
+// it has been submitted. ImGui renders through its own backend and is not included.
+struct RenderStats
+{
+	uint32_t drawCalls;
+	uint64_t primitives;
+	uint32_t stateChanges;	// binds, enables and fixed-function state that reached GL
+	uint32_t filteredStateChanges;	// the same calls dropped because nothing changed
+	uint32_t uniformUploads;
+	uint64_t bytesUploaded;
+
+	inline static RenderStats& Get()
+	{
+		static RenderStats frame {};
+		return frame;
+	}
+	inline static void Reset() { Get() = {}; }
+
+	// Small always-on window with the previous frame's counters.
+	static void DrawOverlay(const RenderStats& stats);
+};
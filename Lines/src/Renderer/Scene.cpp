@@ -0,0 +1,147 @@
+#include "Scene.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+#include "Camera.h"
+#include "GLCalls.h"
+#include "Grid.h"
+#include "InfiniteGrid.h"
+#include "LineBatch.h"
+#include "Polyline.h"
+#include "../ShaderBatch.h"
+#include "../Profiler/CpuProfiler.h"
+#include "../Profiler/GpuProfiler.h"
+
+
+Scene::Scene(ShaderBatch& shaders)
+	: m_Shader { nullptr }, m_Box {}, m_BoxBuffer {}, m_BoxIndicesBuffer {},
+	m_Grid { nullptr }, m_InfiniteGrid { nullptr }, m_LineBatch { nullptr },
+	m_ThickLines { nullptr }, m_Polyline { nullptr }, m_FrameBuffer { nullptr }, m_FrameVersion {}
+{
+	m_Shader = shaders.add("res/shaders/shader.vs", "res/shaders/shader.fs");
+
+	float boxVertices[] = {
+		// Positions			// Colors
+		-1.0f, -1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
+		 1.0f, -1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
+		 1.0f,  1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
+		-1.0f,  1.0f, 1.0f,		0.4f, 0.5f, 0.3f,
+
+		-1.0f, -1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
+		 1.0f, -1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
+		 1.0f,  1.0f, -1.0f,	0.2f, 0.8f, 0.5f,
+		-1.0f,  1.0f, -1.0f,	0.2f, 0.8f, 0.5f
+	};
+
+	uint32_t boxIndices[] = {
+		0, 1, 2,	0, 2, 3,
+		4, 5, 6,	4, 6, 7
+	};
+
+	glGenVertexArrays(1, &m_Box);
+	glGenBuffers(1, &m_BoxBuffer);
+	glGenBuffers(1, &m_BoxIndicesBuffer);
+
+	GL::BindVertexArray(m_Box);
+
+	GL::BindBuffer(GL_ARRAY_BUFFER, m_BoxBuffer);
+	GL::BufferData(GL_ARRAY_BUFFER, sizeof(boxVertices), boxVertices, GL_STATIC_DRAW);
+
+	GL::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BoxIndicesBuffer);
+	GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(boxIndices), boxIndices, GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+
+	m_Grid = new Grid(20, 1.f, -5.f, glm::vec3(.7f, .7f, .7f));
+	m_InfiniteGrid = new InfiniteGrid(shaders, -5.f, glm::vec3(.7f, .7f, .7f));
+	m_LineBatch = new LineBatch();
+	m_ThickLines = new ThickLines(shaders);
+	m_FrameBuffer = new UniformBuffer(sizeof(FrameData), UniformBinding::Frame);
+
+	std::vector<LineVertex> spiral;
+	for (int32_t i = 0; i <= 96; i++)
+	{
+		float angle = glm::radians(15.f * i);
+		float radius = (i % 2) ? 4.5f : 3.f;
+		spiral.push_back({ { radius * glm::cos(angle), -4.f + i / 12.f, radius * glm::sin(angle) }, { .9f, .6f, .2f } });
+	}
+	m_Polyline = new Polyline(spiral);
+}
+
+Scene::~Scene()
+{
+	GL::DeleteVertexArrays(1, &m_Box);
+	GL::DeleteBuffers(1, &m_BoxBuffer);
+	GL::DeleteBuffers(1, &m_BoxIndicesBuffer);
+
+	delete m_Grid;
+	delete m_InfiniteGrid;
+	delete m_LineBatch;
+	delete m_ThickLines;
+	delete m_Polyline;
+	delete m_FrameBuffer;
+}
+
+void Scene::draw(const Camera& camera, const SceneSettings& settings, GpuProfiler* profiler)
+{
+	if (camera.getVersion() != m_FrameVersion)
+	{
+		FrameData frame = { camera.getView(), camera.getProjection(), camera.getViewProj(), camera.getInverseViewProj(),
+			glm::vec4(camera.getPosition(), 1.f), camera.getViewport(), glm::vec2(0.f) };
+		m_FrameBuffer->setData(&frame, sizeof(frame));
+		m_FrameVersion = camera.getVersion();
+	}
+
+	// Set every frame rather than once, so nothing depends on what ran before; the state
+	// cache turns the repeats into no-ops.
+	GL::Enable(GL_DEPTH_TEST);
+	GL::Enable(GL_BLEND);
+	GL::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_Shader->bind();
+
+	// The unit box stays inside this cube however it is rotated.
+	constexpr float boxExtent = 1.7321f;
+	if (camera.getFrustum().intersects(glm::vec3(-boxExtent), glm::vec3(boxExtent)))
+	{
+		PROFILE_SCOPE("Box");
+		GpuProfiler::Scope scope(profiler, "Box");
+		GL::BindVertexArray(m_Box);
+		glm::mat4 rotate = glm::rotate(glm::mat4(1.0f), glm::radians(settings.boxRotation.x), glm::vec3(1.0f, 0.0f, 0.0f))
+			* glm::rotate(glm::mat4(1.0f), glm::radians(settings.boxRotation.y), glm::vec3(0.0f, 1.0f, 0.0f))
+			* glm::rotate(glm::mat4(1.0f), glm::radians(settings.boxRotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+		m_Shader->setUniformMat4("u_Model", rotate);
+		GL::DrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, nullptr);
+	}
+
+	{
+		PROFILE_SCOPE("Lines");
+		GpuProfiler::Scope scope(profiler, "Lines");
+		m_Shader->setUniformMat4("u_Model", glm::identity<glm::mat4>());
+		m_LineBatch->drawLine(glm::vec3(0.f), glm::vec3(3.f, 0.f, 0.f), glm::vec3(1.f, 0.2f, 0.2f));
+		m_LineBatch->drawLine(glm::vec3(0.f), glm::vec3(0.f, 3.f, 0.f), glm::vec3(0.2f, 1.f, 0.2f));
+		m_LineBatch->drawLine(glm::vec3(0.f), glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.2f, 0.2f, 1.f));
+		m_LineBatch->flush();
+
+		m_ThickLines->bindPolyline(4.f * settings.lineWidth, settings.join, settings.cap);
+		m_Polyline->draw();
+	}
+
+	{
+		PROFILE_SCOPE("Grid");
+		GpuProfiler::Scope scope(profiler, "Grid");
+		if (settings.infiniteGrid)
+		{
+			m_InfiniteGrid->draw();
+		}
+		else
+		{
+			m_ThickLines->bind(settings.lineWidth, settings.dashed);
+			m_Grid->drawThick();
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include "ThickLines.h"
+#include "UniformBuffer.h"
+
+class Camera;
+class Shader;
+class ShaderBatch;
+class Grid;
+class InfiniteGrid;
+class LineBatch;
+class Polyline;
+class GpuProfiler;
+
+// Everything the scene draw depends on besides the camera, so the application UI and the
+// benchmarks can drive the same frame.
+struct SceneSettings
+{
+	glm::vec3 boxRotation { 23.f, 54.f, 23.f }; // degrees around x, y and z
+	bool infiniteGrid { false };
+	float lineWidth { 2.f };
+	bool dashed { false };
+	JoinStyle join { JoinStyle::Miter };
+	CapStyle cap { CapStyle::Round };
+};
+
+// The box, the axes, the spiral polyline and the floor grid. Shaders are added to the
+// batch on construction and must be finished before the first draw.
+class Scene
+{
+public:
+	Scene(ShaderBatch& shaders);
+	~Scene();
+
+	// Uploads the FrameData block if the camera changed since the last draw, then draws.
+	// The profiler may be null.
+	void draw(const Camera& camera, const SceneSettings& settings, GpuProfiler* profiler = nullptr);
+private:
+	Shader* m_Shader;
+	uint32_t m_Box, m_BoxBuffer, m_BoxIndicesBuffer;
+
+	Grid* m_Grid;
+	InfiniteGrid* m_InfiniteGrid;
+	LineBatch* m_LineBatch;
+	ThickLines* m_ThickLines;
+	Polyline* m_Polyline;
+	UniformBuffer* m_FrameBuffer;
+	uint64_t m_FrameVersion;
+};
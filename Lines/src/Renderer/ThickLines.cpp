@@ -0,0 +1,81 @@
+#include "ThickLines.h"
+#include <glad/glad.h>
+
+#include "GLCalls.h"
+#include "LineBatch.h"
+#include "../ShaderBatch.h"
+
+
+ThickLines::ThickLines(ShaderBatch& shaders)
+	: m_Shader { nullptr }, m_DashedShader { nullptr }, m_PolylineShader { nullptr }
+{
+	m_Shader = shaders.add("res/shaders/thickline.vs", "res/shaders/thickline.fs");
+	m_DashedShader = shaders.add("res/shaders/thickline.vs", "res/shaders/thickline.fs", { "DASHED" });
+	m_PolylineShader = shaders.add("res/shaders/polyline.vs", "res/shaders/polyline.fs");
+}
+
+void ThickLines::bind(float width, bool dashed, float dashLength)
+{
+	Shader* shader = dashed ? m_DashedShader : m_Shader;
+	shader->bind();
+	shader->setUniform1f("u_Width", width);
+	if (dashed)
+		shader->setUniform1f("u_DashLength", dashLength);
+}
+
+void ThickLines::bindPolyline(float width, JoinStyle join, CapStyle cap, float miterLimit)
+{
+	m_PolylineShader->bind();
+	m_PolylineShader->setUniform1f("u_Width", width);
+	m_PolylineShader->setUniform1f("u_MiterLimit", miterLimit);
+	m_PolylineShader->setUniform1i("u_Join", (int32_t)join);
+	m_PolylineShader->setUniform1i("u_Cap", (int32_t)cap);
+}
+
+void ThickLines::setupSegmentAttributes(uint32_t buffer)
+{
+	constexpr GLsizei stride = 2 * sizeof(LineVertex);
+
+	GL::BindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(LineVertex, position));
+	glVertexAttribDivisor(0, 1);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(LineVertex, color));
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(LineVertex) + offsetof(LineVertex, position)));
+	glVertexAttribDivisor(2, 1);
+}
+
+void ThickLines::draw(uint32_t segmentCount)
+{
+	GL::DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, segmentCount);
+}
+
+void ThickLines::setupPolylineAttributes(uint32_t buffer)
+{
+	constexpr GLsizei stride = sizeof(LineVertex);
+
+	GL::BindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	// prev, start, end and next are consecutive vertices, so each instance steps one vertex forward.
+	const uint32_t positions[4] = { 0, 1, 3, 4 };
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		glEnableVertexAttribArray(positions[i]);
+		glVertexAttribPointer(positions[i], 3, GL_FLOAT, GL_FALSE, stride, (void*)(i * sizeof(LineVertex) + offsetof(LineVertex, position)));
+		glVertexAttribDivisor(positions[i], 1);
+	}
+
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(LineVertex) + offsetof(LineVertex, color)));
+	glVertexAttribDivisor(2, 1);
+}
+
+void ThickLines::drawPolyline(uint32_t pointCount)
+{
+	if (pointCount < 2) return;
+	GL::DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, pointCount - 1);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+class Shader;
+class ShaderBatch;
+
+enum class JoinStyle : int32_t
+{
+	Miter, Bevel, Round
+};
+
+enum class CapStyle : int32_t
+{
+	Butt, Square, Round
+};
+
+// Constant pixel-width, anti-aliased lines. Each segment is one instance whose quad is
+// expanded in screen space by res/shaders/thickline.vs, so glLineWidth is never needed.
+class ThickLines
+{
+public:
+	ThickLines(ShaderBatch& shaders);
+
+	// Camera and viewport come from the FrameData uniform block.
+	// The dashed variant is the same shader compiled with DASHED; dash and gap are dashLength pixels each.
+	void bind(float width, bool dashed = false, float dashLength = 8.f);
+	void bindPolyline(float width, JoinStyle join, CapStyle cap, float miterLimit = 4.f);
+
+	// Points the bound VAO at a buffer of LineVertex pairs, consuming one pair per instance.
+	static void setupSegmentAttributes(uint32_t buffer);
+	static void draw(uint32_t segmentCount);
+
+	// Same idea for connected points: each instance also reads its previous and next point
+	// so res/shaders/polyline.vs can build joins. The buffer must repeat its first and last point.
+	static void setupPolylineAttributes(uint32_t buffer);
+	static void drawPolyline(uint32_t pointCount);
+private:
+	Shader* m_Shader;
+	Shader* m_DashedShader;
+	Shader* m_PolylineShader;
+};
@@ -0,0 +1,27 @@
+#include "UniformBuffer.h"
+#include <glad/glad.h>
+
+#include "GLCalls.h"
+#include "../Profiler/CpuProfiler.h"
+
+
+UniformBuffer::UniformBuffer(uint32_t size, uint32_t binding)
+	: m_Buffer {}, m_Binding { binding }
+{
+	glGenBuffers(1, &m_Buffer);
+	GL::BindBuffer(GL_UNIFORM_BUFFER, m_Buffer);
+	GL::BufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	GL::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_Buffer);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	GL::DeleteBuffers(1, &m_Buffer);
+}
+
+void UniformBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+{
+	PROFILE_FUNCTION();
+	GL::BindBuffer(GL_UNIFORM_BUFFER, m_Buffer);
+	GL::BufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
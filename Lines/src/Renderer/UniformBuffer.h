@@ -0,0 +1,35 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Binding points of the uniform blocks shared by every program. Shader binds
+// a block to its slot automatically when it finds the block name after linking.
+namespace UniformBinding
+{
+	constexpr uint32_t Frame = 0;
+}
+
+// Mirrors the std140 "FrameData" block declared by the shaders in res/shaders.
+struct FrameData
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::mat4 viewProj;
+	glm::mat4 invViewProj;
+	glm::vec4 cameraPosition;
+	glm::vec2 viewport;
+	glm::vec2 padding;
+};
+
+static_assert(sizeof(FrameData) == 288, "FrameData must match the std140 layout of the GLSL block");
+
+class UniformBuffer
+{
+public:
+	UniformBuffer(uint32_t size, uint32_t binding);
+	~UniformBuffer();
+
+	void setData(const void* data, uint32_t size, uint32_t offset = 0);
+private:
+	uint32_t m_Buffer;
+	uint32_t m_Binding;
+};
@@ -1,52 +1,192 @@
 #include "Shader.h"
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <utility>
 
 #include "Logger/Logger.h"
+#include "Renderer/GLCalls.h"
+#include "Renderer/UniformBuffer.h"
+#include "Profiler/CpuProfiler.h"
 
+// KHR_parallel_shader_compile is not part of the generated loader.
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
 
-Shader::Shader(const std::string& vsPath, const std::string& fsPath)
-	: m_UniformLocations {}, m_Shader {}
+UniformStats Shader::s_UniformStats {};
+std::string Shader::s_BinaryCacheDirectory { "cache/shaders" };
+
+static std::filesystem::path binaryCachePath(const std::string& directory, uint64_t key)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+	return std::filesystem::path(directory) / name;
+}
+
+static uint32_t uniformTypeSize(GLenum type)
+{
+	switch (type)
+	{
+		case GL_FLOAT_VEC2:  case GL_INT_VEC2:  return 8;
+		case GL_FLOAT_VEC3:  case GL_INT_VEC3:  return 12;
+		case GL_FLOAT_VEC4:  case GL_INT_VEC4:  case GL_FLOAT_MAT2: return 16;
+		case GL_FLOAT_MAT3:  return 36;
+		case GL_FLOAT_MAT4:  return 64;
+		default:             return 4;
+	}
+}
+
+Shader::Shader(const std::string& vsPath, const std::string& fsPath, const std::vector<std::string>& defines, bool deferred)
+	: Shader(ShaderSource::Load(vsPath, fsPath, defines), deferred)
+{
+}
+
+Shader::Shader(ShaderSource source, bool deferred)
+	: m_Shader {}, m_Source { std::move(source) },
+	m_Pending { false }, m_VertexShader {}, m_FragmentShader {}, m_CacheKey {},
+	m_Uniforms {}, m_UniformShadow {}
+{
+	build(deferred);
+}
+
+bool Shader::reload(const std::unordered_map<std::string, std::string>& changedFiles)
 {
-	std::string vsCode;
-	std::string fsCode;
-	std::ifstream vsStream;
-	std::ifstream fsStream;
+	PROFILE_FUNCTION();
+	if (m_Pending) return false;
 
-	vsStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	fsStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	bool affected = std::any_of(changedFiles.begin(), changedFiles.end(),
+		[this](const auto& file) { return m_Source.files.contains(file.first); });
+	if (!affected) return false;
 
-	try
+	// Unchanged files come from the previous load, so reloading never touches the disk.
+	std::unordered_map<std::string, std::string> files = m_Source.files;
+	for (const auto& [path, source] : changedFiles)
 	{
-		vsStream.open(vsPath);
-		fsStream.open(fsPath);
+		files[path] = source;
+	}
+
+	uint32_t previous = m_Shader;
+	std::vector<Uniform> uniforms = std::move(m_Uniforms);
+	std::vector<uint8_t> shadow = std::move(m_UniformShadow);
+	ShaderSource previousSource = std::exchange(m_Source,
+		ShaderSource::Load(m_Source.vertexPath, m_Source.fragmentPath, m_Source.defines, &files));
+
+	build(false);
+	if (!m_Shader)
+	{
+		LOG_ERROR_TO(Shader, "Failed to reload {} / {}, keeping the previous program", m_Source.vertexPath, m_Source.fragmentPath);
+		m_Shader = previous;
+		m_Uniforms = std::move(uniforms);
+		m_UniformShadow = std::move(shadow);
+		m_Source = std::move(previousSource);
+		return false;
+	}
 
-		std::stringstream ss[2];
-		ss[0] << vsStream.rdbuf();
-		ss[1] << fsStream.rdbuf();
+	if (previous) glDeleteProgram(previous);
+	LOG_INFO_TO(Shader, "Reloaded {} / {}", m_Source.vertexPath, m_Source.fragmentPath);
+	return true;
+}
+
+void Shader::build(bool deferred)
+{
+	// The driver string is part of the key, so a driver update never feeds a stale binary back.
+	uint64_t key = m_Source.hash;
+	key = ShaderSource::Hash((const char*)glGetString(GL_VENDOR), key);
+	key = ShaderSource::Hash((const char*)glGetString(GL_RENDERER), key);
+	key = ShaderSource::Hash((const char*)glGetString(GL_VERSION), key);
 
-		vsStream.close();
-		fsStream.close();
+	if (loadBinary(key)) return;
 
-		vsCode = ss[0].str();
-		fsCode = ss[1].str();
+	m_CacheKey = key;
+	m_VertexShader = compileShader(ShaderType::VertexShader, m_Source.vertex);
+	m_FragmentShader = compileShader(ShaderType::FragmentShader, m_Source.fragment);
+	linkProgram(m_VertexShader, m_FragmentShader);
+	m_Pending = true;
+
+	if (!deferred)
+	{
+		finishLink();
 	}
-	catch (std::ifstream::failure e)
+}
+
+bool Shader::IsParallelCompileSupported()
+{
+	static const bool supported = []()
+	{
+		int32_t count = {};
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (int32_t i = 0; i < count; i++)
+		{
+			std::string_view extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (extension != "GL_KHR_parallel_shader_compile" && extension != "GL_ARB_parallel_shader_compile") continue;
+
+			// Let the driver pick its own thread count.
+			auto maxCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress(
+				extension[3] == 'K' ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB");
+			if (maxCompilerThreads) maxCompilerThreads(0xFFFFFFFF);
+			return true;
+		}
+		return false;
+	}();
+
+	return supported;
+}
+
+bool Shader::isLinkComplete() const
+{
+	if (!m_Pending || !IsParallelCompileSupported()) return true;
+
+	int32_t complete = {};
+	glGetProgramiv(m_Shader, GL_COMPLETION_STATUS_KHR, &complete);
+	return complete;
+}
+
+bool Shader::finishLink()
+{
+	if (!m_Pending) return m_Shader != 0;
+	m_Pending = false;
+
+	// Status is only queried here, after every program of a batch has been submitted.
+	// hasError() deletes whatever failed, so only the survivors are released below.
+	bool vsCompiled = !hasError(GL_COMPILE_STATUS, m_VertexShader);
+	bool fsCompiled = !hasError(GL_COMPILE_STATUS, m_FragmentShader);
+	bool linked = vsCompiled && fsCompiled && !hasError(GL_LINK_STATUS, m_Shader, true);
+
+	if (linked)
+	{
+		reflectUniforms();
+		bindUniformBlocks();
+
+		glValidateProgram(m_Shader);
+		hasError(GL_VALIDATE_STATUS, m_Shader, true);
+
+		glDetachShader(m_Shader, m_VertexShader);
+		glDetachShader(m_Shader, m_FragmentShader);
+		saveBinary(m_CacheKey);
+	}
+	else
 	{
-		LOG_ERROR("Cannot read the shader files: \ninfo: \n\t", e.what());
+		if (!vsCompiled || !fsCompiled) glDeleteProgram(m_Shader);
+		m_Shader = 0;
 	}
 
-	uint32_t vs = compileShader(ShaderType::VertexShader, vsCode);
-	uint32_t fs = compileShader(ShaderType::FragmentShader, fsCode);
-	linkProgram(vs, fs);
+	if (vsCompiled) glDeleteShader(m_VertexShader);
+	if (fsCompiled) glDeleteShader(m_FragmentShader);
+	m_VertexShader = m_FragmentShader = 0;
+	return linked;
 }
 
 Shader::~Shader()
 {
 	if (!m_Shader)
 	{
-		LOG_ERROR("Invaild shader program. [In destructor]");
+		LOG_ERROR_TO(Shader, "Invaild shader program. [In destructor]");
 		return;
 	}
 
@@ -55,32 +195,49 @@ Shader::~Shader()
 
 void Shader::bind() const
 {
-	glUseProgram(m_Shader);
+	GL::UseProgram(m_Shader);
 }
 
 void Shader::unbind() const
 {
-	glUseProgram(0);
+	GL::UseProgram(0);
+}
+
+void Shader::setUniformMat4(UniformName name, const glm::mat4& mat)
+{
+	int32_t location = shadowUniform(name, glm::value_ptr(mat), sizeof(mat));
+	if (location < 0) return;
+	GL::UniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
 }
 
-void Shader::setUniformMat4(const std::string& name, glm::mat4 mat)
+void Shader::setUniform1i(UniformName name, int32_t value)
 {
-	glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+	int32_t location = shadowUniform(name, &value, sizeof(value));
+	if (location < 0) return;
+	GL::Uniform1i(location, value);
 }
 
-void Shader::setUniform1f(const std::string& name, float value)
+void Shader::setUniform1f(UniformName name, float value)
 {
-	glUniform1f(getUniformLocation(name), value);
+	int32_t location = shadowUniform(name, &value, sizeof(value));
+	if (location < 0) return;
+	GL::Uniform1f(location, value);
 }
 
-void Shader::setUniform2f(const std::string& name, float v0, float v1)
+void Shader::setUniform2f(UniformName name, float v0, float v1)
 {
-	glUniform2f(getUniformLocation(name), v0, v1);
+	const float values[2] = { v0, v1 };
+	int32_t location = shadowUniform(name, values, sizeof(values));
+	if (location < 0) return;
+	GL::Uniform2f(location, v0, v1);
 }
 
-void Shader::setUniform3f(const std::string& name, float v0, float v1, float v2)
+void Shader::setUniform3f(UniformName name, float v0, float v1, float v2)
 {
-	glUniform3f(getUniformLocation(name), v0, v1, v2);
+	const float values[3] = { v0, v1, v2 };
+	int32_t location = shadowUniform(name, values, sizeof(values));
+	if (location < 0) return;
+	GL::Uniform3f(location, v0, v1, v2);
 }
 
 uint32_t Shader::compileShader(const ShaderType type, const std::string& source)
@@ -92,40 +249,178 @@ uint32_t Shader::compileShader(const ShaderType type, const std::string& source)
 	const char* src = source.c_str();
 	glShaderSource(shader, 1, &src, nullptr);
 	glCompileShader(shader);
-	hasError(GL_COMPILE_STATUS, shader);
 
 	return shader;
 }
 
-bool Shader::linkProgram(const uint32_t vs, const uint32_t fs)
+void Shader::linkProgram(const uint32_t vs, const uint32_t fs)
 {
 	m_Shader = glCreateProgram();
 	glAttachShader(m_Shader, vs);
 	glAttachShader(m_Shader, fs);
 
+	if (GLAD_GL_VERSION_4_1)
+	{
+		glProgramParameteri(m_Shader, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	glLinkProgram(m_Shader);
-	hasError(GL_LINK_STATUS, m_Shader, true);
+}
+
+bool Shader::loadBinary(uint64_t key)
+{
+	// glProgramBinary is core since 4.1; older contexts always compile from source.
+	if (s_BinaryCacheDirectory.empty() || !GLAD_GL_VERSION_4_1) return false;
+
+	std::ifstream stream(binaryCachePath(s_BinaryCacheDirectory, key), std::ios::binary);
+	if (!stream) return false;
 
-	glValidateProgram(m_Shader);
-	hasError(GL_VALIDATE_STATUS, m_Shader, true);
+	uint32_t format = {};
+	if (!stream.read((char*)&format, sizeof(format))) return false;
 
-	glDetachShader(m_Shader, vs);
-	glDetachShader(m_Shader, fs);
-	glDeleteShader(vs);
-	glDeleteShader(fs);
+	std::vector<char> binary((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	if (binary.empty()) return false;
+
+	m_Shader = glCreateProgram();
+	glProgramBinary(m_Shader, format, binary.data(), (GLsizei)binary.size());
+
+	int32_t result = {};
+	glGetProgramiv(m_Shader, GL_LINK_STATUS, &result);
+	if (!result)
+	{
+		LOG_WARN_TO(Shader, "Cached shader binary was rejected, compiling from source");
+		glDeleteProgram(m_Shader);
+		m_Shader = 0;
+		return false;
+	}
+
+	reflectUniforms();
+	bindUniformBlocks();
 	return true;
 }
 
-int32_t Shader::getUniformLocation(const std::string& name)
+void Shader::saveBinary(uint64_t key) const
 {
-	if (m_UniformLocations.find(name) != m_UniformLocations.end())
+	if (s_BinaryCacheDirectory.empty() || !GLAD_GL_VERSION_4_1) return;
+
+	int32_t formats = {};
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if (formats == 0) return;
+
+	int32_t length = {};
+	glGetProgramiv(m_Shader, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length == 0) return;
+
+	std::vector<char> binary(length);
+	GLenum format = {};
+	glGetProgramBinary(m_Shader, length, &length, &format, binary.data());
+
+	std::error_code error;
+	std::filesystem::create_directories(s_BinaryCacheDirectory, error);
+
+	std::ofstream stream(binaryCachePath(s_BinaryCacheDirectory, key), std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		LOG_WARN_TO(Shader, "Cannot write the shader cache to {}", s_BinaryCacheDirectory);
+		return;
+	}
+
+	uint32_t storedFormat = format;
+	stream.write((const char*)&storedFormat, sizeof(storedFormat));
+	stream.write(binary.data(), length);
+}
+
+int32_t Shader::getUniformLocation(UniformName name) const
+{
+	int32_t index = findUniform(name);
+	return index < 0 ? -1 : m_Uniforms[index].location;
+}
+
+int32_t Shader::findUniform(UniformName name) const
+{
+	auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), name.getHash(),
+		[](const Uniform& uniform, uint32_t hash) { return uniform.hash < hash; });
+
+	if (it == m_Uniforms.end() || it->hash != name.getHash())
 	{
-		return m_UniformLocations[name];
+		return -1;
 	}
 
-	int32_t location = glGetUniformLocation(m_Shader, name.c_str());
-	m_UniformLocations[name] = location;
-	return location;
+	return (int32_t)(it - m_Uniforms.begin());
+}
+
+int32_t Shader::shadowUniform(UniformName name, const void* data, uint32_t size)
+{
+	int32_t index = findUniform(name);
+	if (index < 0) return -1;
+
+	Uniform* uniform = &m_Uniforms[index];
+	uint8_t* shadow = m_UniformShadow.data() + uniform->offset;
+	size = std::min(size, uniform->size);
+
+	if (uniform->isSet && std::memcmp(shadow, data, size) == 0)
+	{
+		s_UniformStats.skipped++;
+		return -1;
+	}
+
+	std::memcpy(shadow, data, size);
+	uniform->isSet = true;
+	s_UniformStats.uploads++;
+	return uniform->location;
+}
+
+void Shader::reflectUniforms()
+{
+	int32_t count = {}, maxLength = {};
+	glGetProgramiv(m_Shader, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(m_Shader, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	std::string name(maxLength, '\0');
+	m_Uniforms.clear();
+	m_Uniforms.reserve(count);
+
+	uint32_t shadowSize = 0;
+	for (int32_t i = 0; i < count; i++)
+	{
+		int32_t length = {}, size = {};
+		GLenum type = {};
+		glGetActiveUniform(m_Shader, i, maxLength, &length, &size, &type, name.data());
+
+		std::string_view uniform(name.data(), length);
+		// Arrays are reported as "name[0]", but are set through their plain name.
+		if (uniform.ends_with("[0]"))
+		{
+			uniform.remove_suffix(3);
+		}
+
+		// Members of uniform blocks have no location.
+		int32_t location = glGetUniformLocation(m_Shader, name.c_str());
+		if (location < 0) continue;
+
+		uint32_t typeSize = uniformTypeSize(type);
+		m_Uniforms.push_back({ UniformName::hash(uniform), location, shadowSize, typeSize, false });
+		shadowSize += typeSize;
+	}
+
+	std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+		[](const Uniform& a, const Uniform& b) { return a.hash < b.hash; });
+	m_UniformShadow.assign(shadowSize, 0);
+}
+
+void Shader::bindUniformBlocks()
+{
+	static constexpr std::pair<const char*, uint32_t> blocks[] = {
+		{ "FrameData", UniformBinding::Frame }
+	};
+
+	for (const auto& [name, binding] : blocks)
+	{
+		uint32_t index = glGetUniformBlockIndex(m_Shader, name);
+		if (index == GL_INVALID_INDEX) continue;
+
+		glUniformBlockBinding(m_Shader, index, binding);
+	}
 }
 
 bool Shader::hasError(uint32_t status, uint32_t id, bool isProgram)
@@ -142,9 +437,8 @@ bool Shader::hasError(uint32_t status, uint32_t id, bool isProgram)
 			char* infoLog = new char[length];
 			glGetProgramInfoLog(id, length, &length, infoLog);
 
-			LOG_ERROR("Failed to link shader program!");
-			LOG_ERROR("Error Infomation: \n");
-			LOG_TRACE("{}", infoLog);
+			// One error-level call, so release builds still print the driver's message.
+			LOG_ERROR_TO(Shader, "Failed to link shader program!\n{}", infoLog);
 
 			delete[] infoLog;
 			glDeleteProgram(id);
@@ -163,8 +457,7 @@ bool Shader::hasError(uint32_t status, uint32_t id, bool isProgram)
 		GLchar* infoLog = new GLchar[length];
 		glGetShaderInfoLog(id, length, &length, infoLog);
 
-		LOG_ERROR("Error Infomation: \n");
-		LOG_TRACE("{}", infoLog);
+		LOG_ERROR_TO(Shader, "Failed to compile shader!\n{}", infoLog);
 
 		delete[] infoLog;
 		glDeleteShader(id);
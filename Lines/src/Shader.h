@@ -1,14 +1,66 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
+#include "ShaderSource.h"
+
+// Uniform name hashed at compile time, so setting a uniform from a string literal
+// neither allocates nor hashes at runtime.
+class UniformName
+{
+public:
+	template<size_t N>
+	consteval UniformName(const char (&name)[N])
+		: m_Hash { hash(std::string_view(name, N - 1)) }
+	{
+	}
+
+	static constexpr uint32_t hash(std::string_view name)
+	{
+		uint32_t hash = 2166136261u; // FNV-1a
+		for (char c : name)
+		{
+			hash = (hash ^ (uint8_t)c) * 16777619u;
+		}
+		return hash;
+	}
+
+	inline uint32_t getHash() const { return m_Hash; }
+private:
+	uint32_t m_Hash;
+};
+
+struct UniformStats
+{
+	uint32_t uploads;
+	uint32_t skipped;
+};
+
 class Shader
 {
 public:
-	Shader(const std::string& vsPath, const std::string& fsPath);
+	// A deferred shader only submits compile and link; call finishLink() (or let a
+	// ShaderBatch do it) before using it, so the driver can compile in the background.
+	Shader(const std::string& vsPath, const std::string& fsPath, const std::vector<std::string>& defines = {}, bool deferred = false);
+	Shader(ShaderSource source, bool deferred = false);
 	~Shader();
 
+	// Non-blocking where KHR_parallel_shader_compile is available, otherwise always true.
+	bool isLinkComplete() const;
+	bool finishLink();
+
+	inline bool isPending() const { return m_Pending; }
+
+	// Rebuilds the program when any of its files (includes too) is in `changedFiles`,
+	// keyed by normalized path. On failure the previous program is kept.
+	bool reload(const std::unordered_map<std::string, std::string>& changedFiles);
+
+	inline const ShaderSource& getSource() const { return m_Source; }
+	static bool IsParallelCompileSupported();
+
 	void bind() const;
 	void unbind() const;
 public:
@@ -17,23 +69,61 @@ public:
 	//{
 	//}
 public:
-	void setUniform1f(const std::string& name, float value);
-	void setUniform2f(const std::string& name, float v0, float v1);
-	void setUniform3f(const std::string& name, float v0, float v1, float v2);
-	void setUniformMat4(const std::string& name, glm::mat4 mat);
+	void setUniform1i(UniformName name, int32_t value);
+	void setUniform1f(UniformName name, float value);
+	void setUniform2f(UniformName name, float v0, float v1);
+	void setUniform3f(UniformName name, float v0, float v1, float v2);
+	void setUniformMat4(UniformName name, const glm::mat4& mat);
+
+	// Returns -1 for names the linker did not keep, which glUniform* silently ignores.
+	int32_t getUniformLocation(UniformName name) const;
+
+	// Linked programs are stored here by glGetProgramBinary and reloaded on the next launch.
+	// An empty path disables the cache.
+	inline static void SetBinaryCacheDirectory(const std::string& directory) { s_BinaryCacheDirectory = directory; }
+
+	// Uploads issued and skipped by all programs since the last reset.
+	inline static UniformStats& GetUniformStats() { return s_UniformStats; }
+	inline static void ResetUniformStats() { s_UniformStats = {}; }
 private:
+	struct Uniform
+	{
+		uint32_t hash;
+		int32_t location;
+		uint32_t offset, size; // Range of the last uploaded value in m_UniformShadow
+		bool isSet;
+	};
+
 	enum class ShaderType : int8_t
 	{
 		NONE = -1, VertexShader, FragmentShader
 	};
 
+	void build(bool deferred);
 	uint32_t compileShader(const ShaderType type, const std::string& source);
-	bool linkProgram(const uint32_t vs, const uint32_t fs);
-	int32_t getUniformLocation(const std::string& name);
+	void linkProgram(const uint32_t vs, const uint32_t fs);
+	bool loadBinary(uint64_t key);
+	void saveBinary(uint64_t key) const;
+	void reflectUniforms();
+	void bindUniformBlocks();
+	int32_t findUniform(UniformName name) const;
+	// Returns the location to upload to, or -1 when the value matches the last upload.
+	int32_t shadowUniform(UniformName name, const void* data, uint32_t size);
 	bool hasError(uint32_t status, uint32_t id, bool isProgram = false);
 private:
 	uint32_t m_Shader;
 
-	std::unordered_map<std::string, int32_t> m_UniformLocations;
+	ShaderSource m_Source;
+
+	bool m_Pending;
+	uint32_t m_VertexShader, m_FragmentShader;
+	uint64_t m_CacheKey;
+
+	// Active uniforms sorted by name hash, filled once right after linking.
+	std::vector<Uniform> m_Uniforms;
+	std::vector<uint8_t> m_UniformShadow;
+
+	static UniformStats s_UniformStats;
+	static std::string s_BinaryCacheDirectory;
 };
 
@@ -0,0 +1,71 @@
+#include "ShaderBatch.h"
+#include <algorithm>
+
+
+ShaderBatch::ShaderBatch()
+	: m_Pending {}, m_Shaders {}, m_Variants {}
+{
+}
+
+ShaderBatch::~ShaderBatch()
+{
+	for (Shader* shader : m_Shaders)
+	{
+		delete shader;
+	}
+}
+
+Shader* ShaderBatch::add(const std::string& vsPath, const std::string& fsPath, const std::vector<std::string>& defines)
+{
+	ShaderSource source = ShaderSource::Load(vsPath, fsPath, defines);
+
+	auto it = m_Variants.find(source.hash);
+	if (it != m_Variants.end())
+	{
+		return it->second;
+	}
+
+	Shader* shader = new Shader(std::move(source), true);
+	m_Shaders.push_back(shader);
+	m_Variants[shader->getSource().hash] = shader;
+
+	// Programs served from the binary cache are ready straight away.
+	if (shader->isPending())
+	{
+		m_Pending.push_back(shader);
+	}
+
+	return shader;
+}
+
+bool ShaderBatch::poll()
+{
+	if (m_Pending.empty()) return true;
+
+	if (!Shader::IsParallelCompileSupported())
+	{
+		m_Pending.front()->finishLink();
+		m_Pending.erase(m_Pending.begin());
+		return m_Pending.empty();
+	}
+
+	std::erase_if(m_Pending, [](Shader* shader)
+	{
+		if (!shader->isLinkComplete()) return false;
+
+		shader->finishLink();
+		return true;
+	});
+
+	return m_Pending.empty();
+}
+
+void ShaderBatch::finish()
+{
+	for (Shader* shader : m_Pending)
+	{
+		shader->finishLink();
+	}
+
+	m_Pending.clear();
+}
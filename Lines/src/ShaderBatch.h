@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+
+// Submits every program before asking for any compile or link status, so the driver can
+// compile them in parallel while the application keeps presenting frames. The batch owns
+// its shaders, and variants whose preprocessed sources hash the same share one program.
+class ShaderBatch
+{
+public:
+	ShaderBatch();
+	~ShaderBatch();
+
+	// The returned shader is usable once poll() reports it done.
+	Shader* add(const std::string& vsPath, const std::string& fsPath, const std::vector<std::string>& defines = {});
+
+	// Finishes what is ready without blocking and returns true once nothing is pending.
+	// Without KHR_parallel_shader_compile one program is finished per call instead.
+	bool poll();
+	void finish();
+
+	inline uint32_t getPendingCount() const { return (uint32_t)m_Pending.size(); }
+	inline uint32_t getTotalCount() const { return (uint32_t)m_Shaders.size(); }
+	inline const std::vector<Shader*>& getShaders() const { return m_Shaders; }
+private:
+	std::vector<Shader*> m_Pending;
+	std::vector<Shader*> m_Shaders;
+	std::unordered_map<uint64_t, Shader*> m_Variants;
+};
@@ -0,0 +1,134 @@
+#include "ShaderSource.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+#include "Logger/Logger.h"
+
+namespace
+{
+	struct Preprocessor
+	{
+		const std::unordered_map<std::string, std::string>* overrides;
+		std::unordered_map<std::string, std::string>& files;
+		std::unordered_set<std::string> included;
+		std::ostringstream output;
+		int32_t sourceCount;
+
+		bool read(const std::string& path, std::string& source)
+		{
+			if (overrides)
+			{
+				auto it = overrides->find(path);
+				if (it != overrides->end())
+				{
+					source = it->second;
+					files[path] = source;
+					return true;
+				}
+			}
+
+			std::ifstream stream(path);
+			if (!stream)
+			{
+				LOG_ERROR_TO(Shader, "Cannot read the shader file: {}", path);
+				return false;
+			}
+
+			std::stringstream ss;
+			ss << stream.rdbuf();
+			source = ss.str();
+			files[path] = source;
+			return true;
+		}
+
+		void expand(const std::string& path, const std::vector<std::string>& defines)
+		{
+			std::string source;
+			if (!included.insert(path).second || !read(path, source)) return;
+
+			// #line takes a source string number rather than a name, so number files in include order.
+			int32_t sourceIndex = sourceCount++;
+			if (sourceIndex > 0) output << "#line 1 " << sourceIndex << '\n';
+
+			std::istringstream lines(source);
+			std::string line;
+			int32_t lineNumber = 0;
+			while (std::getline(lines, line))
+			{
+				lineNumber++;
+
+				std::string_view directive(line);
+				directive.remove_prefix(std::min(directive.find_first_not_of(" \t"), directive.size()));
+
+				if (directive.starts_with("#version"))
+				{
+					output << line << '\n';
+					for (const std::string& define : defines)
+					{
+						std::string text = define;
+						std::replace(text.begin(), text.end(), '=', ' ');
+						output << "#define " << text << '\n';
+					}
+					output << "#line " << lineNumber + 1 << ' ' << sourceIndex << '\n';
+					continue;
+				}
+
+				if (directive.starts_with("#include"))
+				{
+					size_t first = directive.find('"');
+					size_t last = directive.rfind('"');
+					if (first == std::string_view::npos || last <= first)
+					{
+						LOG_ERROR_TO(Shader, "Malformed #include in {}:{}", path, lineNumber);
+						continue;
+					}
+
+					std::filesystem::path file = std::filesystem::path(path).parent_path() / directive.substr(first + 1, last - first - 1);
+					expand(ShaderSource::NormalizePath(file.string()), {});
+					output << "#line " << lineNumber + 1 << ' ' << sourceIndex << '\n';
+					continue;
+				}
+
+				output << line << '\n';
+			}
+		}
+	};
+}
+
+ShaderSource ShaderSource::Load(const std::string& vsPath, const std::string& fsPath, std::vector<std::string> defines,
+	const std::unordered_map<std::string, std::string>* overrides)
+{
+	std::sort(defines.begin(), defines.end());
+	defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+
+	ShaderSource result = { .vertexPath = vsPath, .fragmentPath = fsPath, .defines = defines,
+		.vertex = {}, .fragment = {}, .hash = 0, .files = {} };
+
+	Preprocessor vertex = { .overrides = overrides, .files = result.files, .included = {}, .output = {}, .sourceCount = 0 };
+	vertex.expand(NormalizePath(vsPath), defines);
+	result.vertex = vertex.output.str();
+
+	Preprocessor fragment = { .overrides = overrides, .files = result.files, .included = {}, .output = {}, .sourceCount = 0 };
+	fragment.expand(NormalizePath(fsPath), defines);
+	result.fragment = fragment.output.str();
+
+	result.hash = Hash(result.fragment, Hash(result.vertex));
+	return result;
+}
+
+std::string ShaderSource::NormalizePath(const std::string& path)
+{
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+uint64_t ShaderSource::Hash(std::string_view data, uint64_t hash)
+{
+	for (char c : data)
+	{
+		hash = (hash ^ (uint8_t)c) * 1099511628211ull; // FNV-1a
+	}
+	return hash;
+}
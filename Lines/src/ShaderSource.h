@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Preprocessed sources of one shader variant. Loading resolves #include "file" relative to
+// the including file (each file is pulled in once) and injects the defines right after
+// #version, so permutations such as DASHED are specialized at compile time.
+struct ShaderSource
+{
+	std::string vertexPath, fragmentPath;
+	std::vector<std::string> defines; // "NAME" or "NAME=VALUE", sorted
+
+	std::string vertex, fragment;
+	uint64_t hash; // Of both preprocessed sources; identical variants share it
+
+	// Raw contents of every file read, keyed by normalized path.
+	std::unordered_map<std::string, std::string> files;
+
+	// Files found in `overrides` are taken from there instead of the disk.
+	static ShaderSource Load(const std::string& vsPath, const std::string& fsPath, std::vector<std::string> defines,
+		const std::unordered_map<std::string, std::string>* overrides = nullptr);
+
+	static std::string NormalizePath(const std::string& path);
+	static uint64_t Hash(std::string_view data, uint64_t hash = 14695981039346656037ull);
+};
@@ -0,0 +1,143 @@
+#include "ShaderWatcher.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Shader.h"
+#include "Logger/Logger.h"
+#include "Profiler/CpuProfiler.h"
+
+ShaderWatcher::ShaderWatcher(const std::string& directory)
+	: m_Directory { directory }, m_Shaders {}, m_Thread {},
+	m_Running { true }, m_HasChanges { false }, m_Mutex {}, m_Changed {}
+{
+	m_Thread = std::thread([this]()
+	{
+		CpuProfiler::SetThreadName("ShaderWatcher");
+		run();
+	});
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+	m_Running = false;
+	if (m_Thread.joinable())
+	{
+		m_Thread.join();
+	}
+}
+
+void ShaderWatcher::watch(Shader* shader)
+{
+	m_Shaders.push_back(shader);
+}
+
+void ShaderWatcher::update()
+{
+	if (!m_HasChanges) return;
+
+	std::unordered_map<std::string, std::string> changed;
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+		if (!lock.owns_lock()) return;
+
+		changed.swap(m_Changed);
+		m_HasChanges = false;
+	}
+
+	for (Shader* shader : m_Shaders)
+	{
+		shader->reload(changed);
+	}
+}
+
+void ShaderWatcher::readChangedFile(const std::string& name)
+{
+	PROFILE_FUNCTION();
+	std::string path = ShaderSource::NormalizePath((std::filesystem::path(m_Directory) / name).string());
+
+	std::ifstream stream(path);
+	if (!stream) return;
+
+	std::stringstream source;
+	source << stream.rdbuf();
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Changed[path] = source.str();
+	m_HasChanges = true;
+}
+
+#ifdef __linux__
+
+void ShaderWatcher::run()
+{
+	int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0 || inotify_add_watch(fd, m_Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		LOG_ERROR_TO(Shader, "Cannot watch shader directory {}", m_Directory);
+		if (fd >= 0) close(fd);
+		return;
+	}
+
+	alignas(inotify_event) char buffer[4096];
+	while (m_Running)
+	{
+		// Wake up periodically so the destructor can stop the thread.
+		pollfd request = { fd, POLLIN, 0 };
+		if (poll(&request, 1, 200) <= 0) continue;
+
+		ssize_t length = read(fd, buffer, sizeof(buffer));
+		for (ssize_t offset = 0; offset < length; )
+		{
+			const inotify_event* event = (const inotify_event*)(buffer + offset);
+			if (event->len > 0)
+			{
+				readChangedFile(event->name);
+			}
+			offset += sizeof(inotify_event) + event->len;
+		}
+	}
+
+	close(fd);
+}
+
+#else
+
+void ShaderWatcher::run()
+{
+	namespace fs = std::filesystem;
+	std::unordered_map<std::string, fs::file_time_type> timestamps;
+
+	std::error_code error;
+	for (const auto& entry : fs::directory_iterator(m_Directory, error))
+	{
+		timestamps[entry.path().filename().string()] = entry.last_write_time(error);
+	}
+
+	while (m_Running)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+		for (const auto& entry : fs::directory_iterator(m_Directory, error))
+		{
+			std::string name = entry.path().filename().string();
+			fs::file_time_type time = entry.last_write_time(error);
+			if (error) continue;
+
+			auto it = timestamps.find(name);
+			if (it != timestamps.end() && it->second == time) continue;
+
+			timestamps[name] = time;
+			readChangedFile(name);
+		}
+	}
+}
+
+#endif
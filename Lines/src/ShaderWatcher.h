@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Shader;
+
+// Watches a shader directory on a background thread (inotify on Linux, timestamp polling
+// elsewhere) and reads changed files there, so the render thread never touches the disk.
+class ShaderWatcher
+{
+public:
+	ShaderWatcher(const std::string& directory);
+	~ShaderWatcher();
+
+	void watch(Shader* shader);
+
+	// Rebuilds watched shaders whose sources changed. Call between frames; never blocks.
+	void update();
+private:
+	void run();
+	void readChangedFile(const std::string& name);
+private:
+	std::string m_Directory;
+	std::vector<Shader*> m_Shaders;
+
+	std::thread m_Thread;
+	std::atomic<bool> m_Running;
+	std::atomic<bool> m_HasChanges;
+
+	std::mutex m_Mutex;
+	std::unordered_map<std::string, std::string> m_Changed; // path -> new source, guarded by m_Mutex
+};
@@ -4,28 +4,42 @@
 #include <glad/glad.h>
 
 
-Window::Window(int32_t width, int32_t height, const std::string& title)
-	: m_Width { width }, m_Height { height }, m_Title { title }, m_Window { nullptr }
+Window::Window(int32_t width, int32_t height, const std::string& title, bool headless)
+	: m_Width { width }, m_Height { height }, m_Title { title }, m_Headless { headless }, m_Window { nullptr }
 {
 	if (!glfwInit()) // make sure glfw is already initialized.
 	{
 		LOG_ERROR("Failed to initialize GLFW!");
-		__debugbreak();
+		if (headless) return;
+		DEBUG_BREAK();
 	}
 
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+#ifdef LINES_DEBUG
+	// Debug contexts report errors and driver warnings through KHR_debug (see GLDebug).
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+
 #ifdef __APPLE__
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
 #endif
 
+	if (headless)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+	}
+
 	m_Window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
 	if (!m_Window)
 	{
 		LOG_ERROR("Create Window Failed!");
-		__debugbreak();
+		// Usually libOSMesa is missing; the caller checks isValid() and reports it.
+		if (headless) return;
+		DEBUG_BREAK();
 	}
 
 	this->setup();
@@ -36,7 +50,8 @@ Window::Window(int32_t width, int32_t height, const std::string& title)
 
 Window::~Window()
 {
-	if (!m_Window)
+	// A headless window that failed to open has already said so.
+	if (!m_Window && !m_Headless)
 	{
 		LOG_ERROR("The window is not valid!");
 	}
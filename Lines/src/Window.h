@@ -5,7 +5,10 @@
 class Window
 {
 public:
-	Window(int32_t width, int32_t height, const std::string& title);
+	// A headless window is never shown and renders through OSMesa (libOSMesa must be installed).
+	// GLFW has to be initialized with the null platform (GLFW_PLATFORM_NULL) so no display is needed.
+	// A headless window that fails to open is left invalid instead of breaking into the debugger.
+	Window(int32_t width, int32_t height, const std::string& title, bool headless = false);
 	~Window();
 
 	void makeContexCurrent() const;
@@ -14,11 +17,14 @@ public:
 	bool shouldClose() const;
 
 	inline GLFWwindow* getInstance() { return m_Window; }
+	inline bool isHeadless() const { return m_Headless; }
+	inline bool isValid() const { return m_Window != nullptr; }
 private:
 	void setup();
 private:
 	int32_t m_Width, m_Height;
 	std::string m_Title;
+	bool m_Headless;
 
 	GLFWwindow* m_Window;
 };
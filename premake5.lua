@@ -78,10 +78,87 @@ project "Lines"
 		systemversion "latest"
 
 	filter "configurations:Debug"
+		defines "LINES_DEBUG"
 		symbols "On"
 
 	filter "configurations:Release"
+		defines "LINES_RELEASE"
 		optimize "On"
 
 	filter "configurations:Dist"
+		defines "LINES_DIST"
+		optimize "On"
+
+
+-- Headless benchmarks. Builds the renderer sources of Lines without its entry point and runs
+-- through GLFW's null platform with an OSMesa context, so no display or GPU is needed.
+-- Run from the Lines directory so res/ resolves, e.g. "Benchmark scene --frames 600".
+project "Benchmark"
+	location "Benchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+	debugdir "Lines"
+
+	defines 
+	{
+		"GLFW_INCLUDE_NONE",
+		"SPDLOG_COMPILED_LIB"
+	}
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp",
+		"Lines/src/**.h",
+		"Lines/src/**.cpp",
+		"Lines/vendor/spdlog/**.h",
+		"Lines/vendor/spdlog/**.cpp",
+		"Lines/vendor/imgui/**.h",
+		"Lines/vendor/imgui/**.cpp",
+	}
+
+	removefiles
+	{
+		"Lines/src/AppIication.cpp",
+		"Lines/vendor/imgui/imgui/main.cpp",
+	}
+
+	includedirs
+	{
+		"%{IncludeDir.GLFW}",
+		"%{IncludeDir.Glad}",
+		"Lines/src",
+		"Lines/vendor/spdlog/include",
+		"Lines/vendor/glm",
+		"Lines/vendor/imgui"
+	}
+
+	links 
+	{
+		"GLFW",
+		"Glad"
+	}
+
+	filter "system:Windows"
+		staticruntime "Off"
+		systemversion "latest"
+		links { "opengl32.lib" }
+
+	filter "system:linux"
+		links { "X11", "dl", "pthread" }
+
+	filter "configurations:Debug"
+		defines "LINES_DEBUG"
+		symbols "On"
+
+	filter "configurations:Release"
+		defines "LINES_RELEASE"
+		optimize "On"
+
+	filter "configurations:Dist"
+		defines "LINES_DIST"
 		optimize "On"